@@ -0,0 +1,97 @@
+#include "CommandQueue.h"
+
+// indices run freely over 0..255; SIZE divides 256, so head - tail is the depth
+bool CommandQueue::post(uint8_t channel, int16_t a, int16_t b, int16_t c) {
+  uint8_t t = __atomic_load_n(&tail, __ATOMIC_ACQUIRE);
+  uint8_t used = (uint8_t)(head - t);
+  if (used >= SIZE) {
+    overflows++;
+    return false;
+  }
+
+  Command& cmd = ring[head & (SIZE - 1)];
+  cmd.channel = channel;
+  cmd.epoch = __atomic_load_n(&epoch, __ATOMIC_RELAXED);
+  cmd.barrier = isBarrier(channel, a, b);
+  cmd.a = a;
+  cmd.b = b;
+  cmd.c = c;
+  __atomic_store_n(&head, (uint8_t)(head + 1), __ATOMIC_RELEASE);
+
+  posted++;
+  if (used + 1 > peakDepth) peakDepth = used + 1;
+  return true;
+}
+
+void CommandQueue::invalidate() {
+  __atomic_store_n(&epoch, (uint8_t)(epoch + 1), __ATOMIC_RELEASE);
+}
+
+bool CommandQueue::isBarrier(uint8_t channel, int16_t a, int16_t b) {
+  return channel == MODE ||
+         (channel == DIRECTION && a == STOP_DIRECTION) ||
+         (channel == DRIVE && b == STOP_DIRECTION);
+}
+
+uint8_t CommandQueue::drain(Command out[SIZE]) {
+  uint8_t h = __atomic_load_n(&head, __ATOMIC_ACQUIRE);
+  uint8_t current = __atomic_load_n(&epoch, __ATOMIC_ACQUIRE);
+
+  uint8_t n = 0;
+  uint8_t start = tail;
+  while (start != h) {
+    // one coalescing window: up to and including the next barrier
+    uint8_t end = start;
+    while (end != h && !ring[end & (SIZE - 1)].barrier) ++end;
+    if (end != h) ++end;
+
+    // newest slot of each channel in the window
+    uint8_t newest[CHANNEL_COUNT] = {};
+    for (uint8_t i = start; i != end; ++i) {
+      const Command& cmd = ring[i & (SIZE - 1)];
+      if (cmd.channel >= CHANNEL_COUNT) continue;
+      newest[cmd.channel] = i;
+    }
+
+    for (uint8_t i = start; i != end; ++i) {
+      const Command& cmd = ring[i & (SIZE - 1)];
+      if (cmd.channel >= CHANNEL_COUNT) continue;
+      if (cmd.epoch != current) {
+        discarded++;
+      } else if (!cmd.barrier && newest[cmd.channel] != i) {
+        coalesced++;
+      } else {
+        out[n++] = cmd;
+      }
+    }
+    start = end;
+  }
+
+  // slots go back to the producer only after they were copied out
+  __atomic_store_n(&tail, h, __ATOMIC_RELEASE);
+  return n;
+}
+
+uint8_t CommandQueue::depth() const {
+  return (uint8_t)(__atomic_load_n(&head, __ATOMIC_ACQUIRE) - __atomic_load_n(&tail, __ATOMIC_ACQUIRE));
+}
+
+uint8_t CommandQueue::getPeakDepth() const {
+  return peakDepth;
+}
+
+uint32_t CommandQueue::getPosted() const {
+  return posted;
+}
+
+uint32_t CommandQueue::getCoalesced() const {
+  return coalesced;
+}
+
+uint32_t CommandQueue::getDiscarded() const {
+  return discarded;
+}
+
+uint32_t CommandQueue::getOverflows() const {
+  return overflows;
+}
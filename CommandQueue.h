@@ -0,0 +1,80 @@
+#ifndef COMMAND_QUEUE_H
+#define COMMAND_QUEUE_H
+
+#include <Arduino.h>
+
+/*
+  Bounded single-producer / single-consumer queue of actuator commands.
+
+  The network front-ends post typed commands; the actuator loop drains
+  them once per control cycle, just before the motor task. A drain keeps
+  only the newest command of each channel, so a burst of slider updates
+  costs one actuation. The survivors are applied in arrival order.
+
+  Some commands do more than set their channel: a mode switch, and a stop
+  (it also ends tank driving). These are barriers. They are always applied
+  and coalescing never reaches across them, so TANK, STOP, FORWARD in one
+  cycle still passes through the stop.
+
+  Lock-free: the producer alone writes head and the consumer alone writes
+  tail, published with release/acquire so this holds against an ISR too.
+  Commands carry an epoch; bumping it (e-stop, failsafe trip) voids
+  everything already queued without touching the consumer's side.
+*/
+class CommandQueue {
+  public:
+    enum Channel : uint8_t {
+      SPEED = 0,  // a = max output 0 ~ 255
+      DIRECTION,  // a = MotorManager::Direction
+      STEERING,   // a = -100 ~ 100
+      MODE,       // a = DriveMixer::Mode
+      TANK,       // a = left, b = right, -255 ~ 255
+      DRIVE,      // whole intent: a = throttle, b = direction, c = steering
+      CHANNEL_COUNT
+    };
+
+    static const int16_t STOP_DIRECTION = 2; // MotorManager::STOP
+
+    struct Command {
+      uint8_t channel = SPEED;
+      uint8_t epoch = 0;
+      bool barrier = false;
+      int16_t a = 0;
+      int16_t b = 0;
+      int16_t c = 0;
+    };
+
+    static const uint8_t SIZE = 16; // power of two
+
+    // producer side; false when full (the command is not queued)
+    bool post(uint8_t channel, int16_t a, int16_t b = 0, int16_t c = 0);
+    // any command posted before this is discarded by the next drain
+    void invalidate();
+    // a mode switch, or a stop on DIRECTION or DRIVE
+    static bool isBarrier(uint8_t channel, int16_t a, int16_t b);
+
+    // consumer side: empties the queue into out, oldest first: every barrier,
+    // and between barriers the newest of each channel; returns how many
+    uint8_t drain(Command out[SIZE]);
+
+    uint8_t depth() const;
+    uint8_t getPeakDepth() const;
+    uint32_t getPosted() const;
+    uint32_t getCoalesced() const; // superseded before they were applied
+    uint32_t getDiscarded() const; // voided by invalidate()
+    uint32_t getOverflows() const; // refused by a full queue
+
+  private:
+    Command ring[SIZE];
+    uint8_t head = 0; // next slot to write, producer owned
+    uint8_t tail = 0; // next slot to read, consumer owned
+    uint8_t epoch = 0;
+
+    uint8_t peakDepth = 0;
+    uint32_t posted = 0;
+    uint32_t overflows = 0;
+    uint32_t coalesced = 0;
+    uint32_t discarded = 0;
+};
+
+#endif
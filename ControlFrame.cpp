@@ -0,0 +1,62 @@
+#include "ControlFrame.h"
+
+static uint8_t checksum(const uint8_t* buf) {
+  uint8_t x = 0;
+  for (size_t i = 0; i < ControlFrame::WIRE_SIZE - 1; ++i) x ^= buf[i];
+  return x;
+}
+
+bool ControlFrame::decode(const uint8_t* buf, size_t len, ControlFrame& out) {
+  if (len != WIRE_SIZE) return false;
+  if (buf[0] != CONTROL_FRAME_VERSION) return false;
+  if (buf[7] != checksum(buf)) return false;
+
+  int8_t steering = (int8_t)buf[6];
+  if (buf[5] > 2) return false;
+  if (steering < -100 || steering > 100) return false;
+
+  out.flags = buf[1];
+  out.seq = (uint16_t)buf[2] | ((uint16_t)buf[3] << 8);
+  out.throttle = buf[4];
+  out.direction = buf[5];
+  out.steering = steering;
+  return true;
+}
+
+void ControlFrame::encode(uint8_t buf[WIRE_SIZE]) const {
+  buf[0] = CONTROL_FRAME_VERSION;
+  buf[1] = flags;
+  buf[2] = seq & 0xFF;
+  buf[3] = seq >> 8;
+  buf[4] = throttle;
+  buf[5] = direction;
+  buf[6] = (uint8_t)steering;
+  buf[7] = checksum(buf);
+}
+
+void TelemetryFrame::encode(uint8_t buf[WIRE_SIZE]) const {
+  buf[0] = CONTROL_FRAME_VERSION;
+  buf[1] = flags;
+  buf[2] = ackSeq & 0xFF;
+  buf[3] = ackSeq >> 8;
+  buf[4] = throttle;
+  buf[5] = direction;
+  buf[6] = (uint8_t)steering;
+  buf[7] = (uint8_t)rssi;
+  buf[8] = staleFrames & 0xFF;
+  buf[9] = staleFrames >> 8;
+  buf[10] = driveMode;
+  buf[11] = (uint16_t)left & 0xFF;
+  buf[12] = (uint16_t)left >> 8;
+  buf[13] = (uint16_t)right & 0xFF;
+  buf[14] = (uint16_t)right >> 8;
+  buf[15] = failsafeTrips & 0xFF;
+  buf[16] = failsafeTrips >> 8;
+  buf[17] = (uint16_t)speedLeft & 0xFF;
+  buf[18] = (uint16_t)speedLeft >> 8;
+  buf[19] = (uint16_t)speedRight & 0xFF;
+  buf[20] = (uint16_t)speedRight >> 8;
+  buf[21] = queueDepth;
+  buf[22] = queueCoalesced & 0xFF;
+  buf[23] = queueCoalesced >> 8;
+}
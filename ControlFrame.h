@@ -0,0 +1,91 @@
+#ifndef CONTROL_FRAME_H
+#define CONTROL_FRAME_H
+
+#include <Arduino.h>
+
+/*
+  One complete driver intent in 8 bytes (little-endian):
+
+    0  version    CONTROL_FRAME_VERSION
+    1  flags      ControlFrame::Flag bits
+    2  seq        uint16, wraps
+    4  throttle   0 ~ 255
+    5  direction  0 FORWARD, 1 BACKWARD, 2 STOP
+    6  steering   int8, -100 (full left) ~ 100 (full right)
+    7  check      xor of bytes 0 ~ 6
+*/
+#define CONTROL_FRAME_VERSION 1
+
+struct ControlFrame {
+  enum Flag : uint8_t {
+    FLAG_RESYNC = 0x01, // sender restarted, accept whatever seq it carries
+    FLAG_ESTOP = 0x02,  // stop now, regardless of direction
+    FLAG_ARM = 0x04     // re-arm a tripped failsafe; only honoured with a stop/zero command
+  };
+
+  static const size_t WIRE_SIZE = 8;
+
+  uint8_t flags = 0;
+  uint16_t seq = 0;
+  uint8_t throttle = 0;
+  uint8_t direction = 2;
+  int8_t steering = 0;
+
+  // false on wrong size, version, checksum or out-of-range fields
+  static bool decode(const uint8_t* buf, size_t len, ControlFrame& out);
+  void encode(uint8_t buf[WIRE_SIZE]) const;
+
+  bool has(Flag f) const { return flags & f; }
+};
+
+/*
+  Applied state sent back to a control sender in 24 bytes (little-endian):
+
+    0  version    CONTROL_FRAME_VERSION
+    1  flags      TelemetryFrame::Flag bits
+    2  ackSeq     sequence of the last applied ControlFrame
+    4  throttle   applied
+    5  direction  applied
+    6  steering   applied, -100 ~ 100
+    7  rssi       dBm, int8
+    8  stale      stale frames dropped so far, uint16 (wraps)
+    10 driveMode  DriveMixer::Mode
+    11 left       int16, PWM on the left channel, -255 ~ 255
+    13 right      int16, PWM on the right channel
+    15 trips      failsafe trips since boot, uint16
+    17 speedLeft  int16, measured wheel speed in mm/s (0 without encoders)
+    19 speedRight int16
+    21 queueDepth commands waiting for the next control cycle
+    22 coalesced  queued commands superseded before being applied, uint16 (wraps)
+
+  Bytes 10 and up were appended later; readers of the first 10 still work.
+*/
+struct TelemetryFrame {
+  enum Flag : uint8_t {
+    FLAG_APPLIED = 0x01, // the datagram being answered was applied
+    FLAG_WIFI_UP = 0x02,
+    FLAG_FAILSAFE = 0x04 // tripped, commands ignored until re-armed
+  };
+
+  static const size_t WIRE_SIZE = 24;
+
+  uint8_t flags = 0;
+  uint16_t ackSeq = 0;
+  uint8_t throttle = 0;
+  uint8_t direction = 2;
+  int8_t steering = 0;
+  int8_t rssi = 0;
+  uint16_t staleFrames = 0;
+  uint8_t driveMode = 0;
+  int16_t left = 0;
+  int16_t right = 0;
+  uint16_t failsafeTrips = 0;
+  int16_t speedLeft = 0;
+  int16_t speedRight = 0;
+  uint8_t queueDepth = 0;
+  uint16_t queueCoalesced = 0;
+
+  void encode(uint8_t buf[WIRE_SIZE]) const;
+};
+
+#endif
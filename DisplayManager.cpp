@@ -1,11 +1,19 @@
 #include "DisplayManager.h"
 
-DisplayManager::DisplayManager() : display(128, 32, &Wire, -1) {}
+// keep the bus at 400 kHz between our own partial transfers too
+DisplayManager::DisplayManager() : display(128, 32, &Wire, -1, 400000UL, 400000UL) {}
 
 void DisplayManager::init() {
-  display.begin(SSD1306_SWITCHCAPVCC, 0x3C);
+  display.begin(SSD1306_SWITCHCAPVCC, I2C_ADDRESS);
+  display.setTextSize(1);
+  display.setTextColor(WHITE);
+  display.setTextWrap(false);
   display.clearDisplay();
+  display.display();
+
+  for (uint8_t r = 0; r < ROWS; ++r) shown[r][0] = '\0';
   stat = DisplayManager::BOOT_START;
+  dirty = true;
   show();
 
   initialized = true;
@@ -13,79 +21,154 @@ void DisplayManager::init() {
 
 void DisplayManager::update(unsigned long now) {
   if (!initialized) return;
+
+  // nothing changed, or we drew too recently
+  if (!dirty || now - lastFrameMs < MIN_FRAME_INTERVAL) {
+    framesSkipped++;
+    return;
+  }
+  show();
+  lastFrameMs = now;
+}
+
+void DisplayManager::flush() {
   show();
+  lastFrameMs = millis();
 }
 
 void DisplayManager::setStat(DisplayManager::BOOTSTAT new_stat) {
+  if (stat == new_stat) return;
   stat = new_stat;
+  dirty = true;
 }
 
 void DisplayManager::setIPAddress(const String& ip) {
+  if (ipAddress == ip) return;
   ipAddress = ip;
+  dirty = true;
 }
 
-void DisplayManager::setInfo(uint8_t max_output, MotorManager::Direction new_dir, ServoManager::Angle new_angle) {
+void DisplayManager::setInfo(uint8_t max_output, MotorManager::Direction new_dir, int8_t new_steering) {
+  if (motor_max_output == max_output && dir == new_dir && steering == new_steering) return;
   motor_max_output = max_output;
   dir = new_dir;
-  angle = new_angle;
+  steering = new_steering;
+  dirty = true;
+}
+
+void DisplayManager::setFailsafe(bool tripped) {
+  if (failsafe == tripped) return;
+  failsafe = tripped;
+  dirty = true;
 }
 
 DisplayManager::BOOTSTAT DisplayManager::getStat() const {
   return stat;
 }
 
+uint32_t DisplayManager::getFramesPushed() const {
+  return framesPushed;
+}
+
+uint32_t DisplayManager::getFramesSkipped() const {
+  return framesSkipped;
+}
+
+uint32_t DisplayManager::getPagesPushed() const {
+  return pagesPushed;
+}
+
 void DisplayManager::show() {
-  display.clearDisplay();
-  display.setTextSize(1);
-  display.setTextColor(WHITE);
-  display.setCursor(0,0);
+  char rows[ROWS][ROW_CHARS + 1];
+  compose(rows);
+  dirty = false;
+
+  // redraw only the rows whose text changed
+  uint8_t mask = 0;
+  for (uint8_t r = 0; r < ROWS; ++r) {
+    if (strcmp(rows[r], shown[r]) == 0) continue;
+
+    display.fillRect(0, r * 8, WIDTH, 8, BLACK);
+    display.setCursor(0, r * 8);
+    display.print(rows[r]);
+    strcpy(shown[r], rows[r]);
+    mask |= 1 << r;
+  }
+
+  if (mask == 0) {
+    framesSkipped++;
+    return;
+  }
+  pushPages(mask);
+  framesPushed++;
+}
+
+void DisplayManager::compose(char rows[ROWS][ROW_CHARS + 1]) {
+  for (uint8_t r = 0; r < ROWS; ++r) rows[r][0] = '\0';
+  const size_t n = ROW_CHARS + 1;
+
   switch (stat) {
     case DisplayManager::BOOT_START:
-      display.println("BOOT START...");
+      snprintf(rows[0], n, "BOOT START...");
       break;
 
     case DisplayManager::WIFI_CONNECTING:
-      display.println("WIFI CONNECTING...");
+      snprintf(rows[0], n, "WIFI CONNECTING...");
       break;
 
     case DisplayManager::WIFI_CONNECTED:
-      display.println("WIFI CONNECTED");
+      snprintf(rows[0], n, "WIFI CONNECTED");
       break;
 
     case DisplayManager::WIFI_GOT_IP:
-      display.println("GOT IP:");
-      display.println(ipAddress);
+      snprintf(rows[0], n, "GOT IP:");
+      snprintf(rows[1], n, "%s", ipAddress.c_str());
       break;
 
     case DisplayManager::WEBSERVER_START:
-      display.println("WEBSERVER START...");
+      snprintf(rows[0], n, "WEBSERVER START...");
       break;
 
-    case DisplayManager::WEBSERVER_READY:
-      display.print("IP: ");
-      display.println(ipAddress);
-
-      display.print("SPD: ");
-      display.print(motor_max_output);
-      display.print(" DIR: ");
-      switch (dir) {
-        case MotorManager::FORWARD:
-          display.println("FWD");
-          break;
-        case MotorManager::BACKWARD:
-          display.println("BACK");
-          break;
-        case MotorManager::STOP:
-          display.println("STOP");
-          break;
-      }
-
-      display.print("STEER: ");
-      if (angle == ServoManager::STR) display.println("STR");
-      else if (angle == ServoManager::LEFT) display.println("LEFT");
-      else if (angle == ServoManager::RIGHT) display.println("RIGHT");
+    case DisplayManager::WEBSERVER_READY: {
+      const char* dirText = "STOP";
+      if (dir == MotorManager::FORWARD) dirText = "FWD";
+      else if (dir == MotorManager::BACKWARD) dirText = "BACK";
+
+      snprintf(rows[0], n, "IP: %s", ipAddress.c_str());
+      snprintf(rows[1], n, "SPD: %u DIR: %s", motor_max_output, dirText);
+      if (steering == 0) snprintf(rows[2], n, "STEER: STR");
+      else snprintf(rows[2], n, "STEER: %s %d", steering < 0 ? "LEFT" : "RIGHT", steering < 0 ? -steering : steering);
+      if (failsafe) snprintf(rows[3], n, "FAILSAFE - RE-ARM");
       break;
+    }
   }
+}
 
-  display.display();
-}
\ No newline at end of file
+void DisplayManager::pushPages(uint8_t mask) {
+  // send the span of pages that covers every changed row
+  uint8_t first = 0;
+  while (!(mask & (1 << first))) first++;
+  uint8_t last = ROWS - 1;
+  while (!(mask & (1 << last))) last--;
+
+  display.ssd1306_command(SSD1306_PAGEADDR);
+  display.ssd1306_command(first);
+  display.ssd1306_command(last);
+  display.ssd1306_command(SSD1306_COLUMNADDR);
+  display.ssd1306_command(0);
+  display.ssd1306_command(WIDTH - 1);
+
+  // horizontal addressing: pages are contiguous in the framebuffer
+  const uint8_t* data = display.getBuffer() + first * WIDTH;
+  size_t remaining = (size_t)(last - first + 1) * WIDTH;
+  while (remaining > 0) {
+    size_t chunk = remaining < 31 ? remaining : 31; // 32-byte Wire buffer incl. control byte
+    Wire.beginTransmission(I2C_ADDRESS);
+    Wire.write((uint8_t)0x40); // data stream
+    Wire.write(data, chunk);
+    Wire.endTransmission();
+    data += chunk;
+    remaining -= chunk;
+  }
+  pagesPushed += last - first + 1;
+}
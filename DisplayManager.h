@@ -13,10 +13,10 @@ class DisplayManager : public BasicManager {
   public:
     enum BOOTSTAT {
       BOOT_START = 0,
-      WIFI_CONNECTING, 
-      WIFI_CONNECTED, 
-      WIFI_GOT_IP, 
-      WEBSERVER_START, 
+      WIFI_CONNECTING,
+      WIFI_CONNECTED,
+      WIFI_GOT_IP,
+      WEBSERVER_START,
       WEBSERVER_READY
     };
 
@@ -25,21 +25,47 @@ class DisplayManager : public BasicManager {
     void init() override;
     void update(unsigned long now) override;
 
+    // redraw right away, ignoring the refresh cap (boot progress)
+    void flush();
+
     void setStat(BOOTSTAT stat);
     void setIPAddress(const String& ip);
-    void setInfo(uint8_t max_output, MotorManager::Direction dir, ServoManager::Angle angle);
+    void setInfo(uint8_t max_output, MotorManager::Direction dir, int8_t steering);
+    void setFailsafe(bool tripped);
     BOOTSTAT getStat() const;
 
+    uint32_t getFramesPushed() const;
+    uint32_t getFramesSkipped() const;
+    uint32_t getPagesPushed() const;
+
   private:
+    static const uint8_t I2C_ADDRESS = 0x3C;
+    static const uint8_t WIDTH = 128;
+    static const uint8_t ROWS = 4;        // 8 px text rows == SSD1306 pages
+    static const uint8_t ROW_CHARS = 21;  // 6 px glyphs
+    static const unsigned long MIN_FRAME_INTERVAL = 100; // ms
+
     Adafruit_SSD1306 display;
     BOOTSTAT stat = BOOT_START;
 
     String ipAddress = "";
     uint8_t motor_max_output = 0;
     MotorManager::Direction dir = MotorManager::FORWARD;
-    ServoManager::Angle angle = ServoManager::STR;
+    int8_t steering = 0;
+    bool failsafe = false;
+
+    // text currently on the panel, row by row
+    char shown[ROWS][ROW_CHARS + 1];
+    bool dirty = true;
+    unsigned long lastFrameMs = 0;
+
+    uint32_t framesPushed = 0;
+    uint32_t framesSkipped = 0;
+    uint32_t pagesPushed = 0;
 
     void show();
+    void compose(char rows[ROWS][ROW_CHARS + 1]);
+    void pushPages(uint8_t mask);
 };
 
-#endif
\ No newline at end of file
+#endif
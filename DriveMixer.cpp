@@ -0,0 +1,55 @@
+#include "DriveMixer.h"
+
+void DriveMixer::mix(Mode mode, int16_t throttle, int8_t steering, int16_t& left, int16_t& right) {
+  int32_t t = constrain(throttle, -255, 255);
+  int32_t s = constrain(steering, -100, 100);
+
+  switch (mode) {
+    case DIFF_ASSIST: {
+      // only ever slows a wheel, so it cannot saturate
+      int32_t inner = t * (100 - (s < 0 ? -s : s) * ASSIST_PERCENT / 100) / 100;
+      left = s < 0 ? inner : t;
+      right = s > 0 ? inner : t;
+      break;
+    }
+
+    case SKID: {
+      int32_t turn = s * 255 / 100;
+      int32_t l = t + turn;
+      int32_t r = t - turn;
+
+      // scale both down together so the turn ratio survives saturation
+      int32_t al = l < 0 ? -l : l;
+      int32_t ar = r < 0 ? -r : r;
+      int32_t m = al > ar ? al : ar;
+      if (m > 255) {
+        l = l * 255 / m;
+        r = r * 255 / m;
+      }
+      left = l;
+      right = r;
+      break;
+    }
+
+    case SERVO_ONLY:
+    case TANK: // the caller supplies both sides itself
+    default:
+      left = t;
+      right = t;
+      break;
+  }
+}
+
+bool DriveMixer::usesServo(Mode mode) {
+  return mode == SERVO_ONLY || mode == DIFF_ASSIST;
+}
+
+const char* DriveMixer::name(Mode mode) {
+  switch (mode) {
+    case SERVO_ONLY: return "servo";
+    case DIFF_ASSIST: return "assist";
+    case SKID: return "skid";
+    case TANK: return "tank";
+    default: return "?";
+  }
+}
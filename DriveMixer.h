@@ -0,0 +1,26 @@
+#ifndef DRIVE_MIXER_H
+#define DRIVE_MIXER_H
+
+#include <Arduino.h>
+
+// Turns throttle (-255..255) and steering (-100..100, right positive) into
+// left/right channel outputs (-255..255).
+class DriveMixer {
+  public:
+    enum Mode : uint8_t {
+      SERVO_ONLY = 0, // both channels equal, the servo steers (classic RC car)
+      DIFF_ASSIST,    // servo steers, inner wheel slowed to tighten the turn
+      SKID,           // arcade mix, no servo: left = t + s, right = t - s
+      TANK,           // left/right commanded directly
+      MODE_COUNT
+    };
+
+    // how much the inner wheel slows at full lock in DIFF_ASSIST, percent
+    static const uint8_t ASSIST_PERCENT = 50;
+
+    static void mix(Mode mode, int16_t throttle, int8_t steering, int16_t& left, int16_t& right);
+    static bool usesServo(Mode mode);
+    static const char* name(Mode mode);
+};
+
+#endif
@@ -0,0 +1,64 @@
+#include "FailsafeManager.h"
+
+// the RA4M1 watchdog; the host backend counts the resets it would cause
+#if defined(FAILSAFE_HW_WATCHDOG) && (defined(ARDUINO_ARCH_RENESAS) || defined(ARDUINO_ARCH_HOST))
+#define HW_WATCHDOG
+#include <WDT.h>
+#endif
+
+void FailsafeManager::init() {
+  state = IDLE;
+#ifdef HW_WATCHDOG
+  WDT.begin(HW_WATCHDOG_MS);
+#endif
+  initialized = true;
+}
+
+void FailsafeManager::update(unsigned long now) {
+  if (!initialized) return;
+#ifdef HW_WATCHDOG
+  WDT.refresh();
+#endif
+
+  if (state != ACTIVE || now - lastFeed <= timeout) return;
+
+  state = TRIPPED;
+  if (trips < 0xFFFF) trips++;
+  if (tripCallback) tripCallback();
+}
+
+bool FailsafeManager::feed(unsigned long now) {
+  if (state == TRIPPED) return false;
+  state = ACTIVE;
+  lastFeed = now;
+  return true;
+}
+
+void FailsafeManager::arm(unsigned long now) {
+  state = IDLE;
+  lastFeed = now;
+}
+
+void FailsafeManager::setTimeout(unsigned long ms) {
+  timeout = ms;
+}
+
+unsigned long FailsafeManager::getTimeout() const {
+  return timeout;
+}
+
+FailsafeManager::State FailsafeManager::getState() const {
+  return state;
+}
+
+bool FailsafeManager::isTripped() const {
+  return state == TRIPPED;
+}
+
+uint16_t FailsafeManager::getTrips() const {
+  return trips;
+}
+
+void FailsafeManager::attachTripCallback(void (*cb)()) {
+  tripCallback = cb;
+}
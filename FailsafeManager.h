@@ -0,0 +1,51 @@
+#ifndef FAILSAFE_MANAGER_H
+#define FAILSAFE_MANAGER_H
+
+#include <Arduino.h>
+#include "BasicManager.h"
+
+// Command freshness watchdog. Every accepted command feeds it; once it has
+// been fed, going `timeout` ms without another trips it. A tripped failsafe
+// refuses commands until someone re-arms it explicitly.
+//
+// -DFAILSAFE_HW_WATCHDOG also starts the RA4M1 hardware watchdog, refreshed
+// from update(), so a loop stuck in the network stack resets the board
+// (outputs go low) instead of driving on. No task may block for anywhere
+// near HW_WATCHDOG_MS; that is why WiFi.begin() does not wait for the join.
+class FailsafeManager : public BasicManager {
+  public:
+    static const unsigned long HW_WATCHDOG_MS = 2000;
+
+    enum State : uint8_t {
+      IDLE = 0, // no command since boot or re-arm, nothing to expire
+      ACTIVE,   // commands arriving, watchdog running
+      TRIPPED   // timed out, outputs forced safe, waiting for re-arm
+    };
+
+    void init() override;
+    void update(unsigned long now) override;
+
+    // heartbeat from a control source; false while tripped (drop the command)
+    bool feed(unsigned long now);
+    // leave TRIPPED; the caller checks that the command is a safe one
+    void arm(unsigned long now);
+
+    void setTimeout(unsigned long ms);
+    unsigned long getTimeout() const;
+    State getState() const;
+    bool isTripped() const;
+    uint16_t getTrips() const;
+
+    // called once per trip, from update()
+    void attachTripCallback(void (*cb)());
+
+  private:
+    State state = IDLE;
+    unsigned long timeout = 500;
+    unsigned long lastFeed = 0;
+    uint16_t trips = 0;
+
+    void (*tripCallback)() = nullptr;
+};
+
+#endif
@@ -0,0 +1,127 @@
+#include "FlightRecorder.h"
+
+void FlightRecorder::record(Type type, Source source, uint16_t seq,
+                            int16_t a, int16_t b, int16_t c, int16_t d) {
+  Record& r = records[head];
+  r.us = micros();
+  r.type = type;
+  r.source = source;
+  r.seq = seq;
+  r.a = a;
+  r.b = b;
+  r.c = c;
+  r.d = d;
+
+  head = (head + 1) % FLIGHT_RECORDER_SIZE;
+  if (filled < FLIGHT_RECORDER_SIZE) filled++;
+  written++;
+}
+
+void FlightRecorder::recordOutput(int16_t left, int16_t right, int16_t servoUs, int16_t failsafe,
+                                  bool ramping, int16_t targetLeft, int16_t targetRight) {
+  if (haveOutput && lastOutput[2] == servoUs && lastOutput[3] == failsafe) {
+    if (lastOutput[0] == left && lastOutput[1] == right) return;
+    // a step of a ramp already on record, still toward the same targets; its
+    // end will be
+    if (ramping && lastRamping && lastTarget[0] == targetLeft && lastTarget[1] == targetRight) return;
+  }
+  lastRamping = ramping;
+  lastTarget[0] = targetLeft;
+  lastTarget[1] = targetRight;
+  lastOutput[0] = left;
+  lastOutput[1] = right;
+  lastOutput[2] = servoUs;
+  lastOutput[3] = failsafe;
+  haveOutput = true;
+  record(ACTUATORS, SOURCE_SELF, 0, left, right, servoUs, failsafe);
+}
+
+size_t FlightRecorder::count() const {
+  return filled;
+}
+
+uint32_t FlightRecorder::total() const {
+  return written;
+}
+
+const FlightRecorder::Record& FlightRecorder::at(size_t i) const {
+  size_t oldest = (head + FLIGHT_RECORDER_SIZE - filled) % FLIGHT_RECORDER_SIZE;
+  return records[(oldest + i) % FLIGHT_RECORDER_SIZE];
+}
+
+size_t FlightRecorder::dumpSize() const {
+  return HEADER_SIZE + filled * RECORD_SIZE;
+}
+
+size_t FlightRecorder::dump(Print& out) const {
+  // serialized field by field, so the blob doesn't depend on struct layout;
+  // batched, a socket write per record would crawl
+  uint8_t buf[HEADER_SIZE + 15 * RECORD_SIZE];
+  memcpy(buf, "RCFR", 4);
+  buf[4] = FLIGHT_RECORDER_VERSION;
+  buf[5] = RECORD_SIZE;
+  put16(buf + 6, (uint16_t)filled);
+  put32(buf + 8, written);
+  put32(buf + 12, micros());
+  size_t len = HEADER_SIZE;
+  size_t n = 0;
+
+  for (size_t i = 0; i < filled; ++i) {
+    const Record& r = at(i);
+    uint8_t* p = buf + len;
+    put32(p, r.us);
+    p[4] = r.type;
+    p[5] = r.source;
+    put16(p + 6, r.seq);
+    put16(p + 8, r.a);
+    put16(p + 10, r.b);
+    put16(p + 12, r.c);
+    put16(p + 14, r.d);
+    len += RECORD_SIZE;
+    if (len == sizeof(buf)) {
+      n += out.write(buf, len);
+      len = 0;
+    }
+  }
+  if (len > 0) n += out.write(buf, len);
+  return n;
+}
+
+bool FlightRecorder::parseHeader(const uint8_t* buf, size_t len, uint16_t& count, uint32_t& total) {
+  if (len < HEADER_SIZE || memcmp(buf, "RCFR", 4) != 0) return false;
+  if (buf[4] != FLIGHT_RECORDER_VERSION || buf[5] != RECORD_SIZE) return false;
+  count = get16(buf + 6);
+  total = get32(buf + 8);
+  return len >= HEADER_SIZE + (size_t)count * RECORD_SIZE;
+}
+
+FlightRecorder::Record FlightRecorder::parseRecord(const uint8_t* buf) {
+  Record r;
+  r.us = get32(buf);
+  r.type = buf[4];
+  r.source = buf[5];
+  r.seq = get16(buf + 6);
+  r.a = (int16_t)get16(buf + 8);
+  r.b = (int16_t)get16(buf + 10);
+  r.c = (int16_t)get16(buf + 12);
+  r.d = (int16_t)get16(buf + 14);
+  return r;
+}
+
+void FlightRecorder::put16(uint8_t* p, uint16_t v) {
+  p[0] = v & 0xFF;
+  p[1] = v >> 8;
+}
+
+void FlightRecorder::put32(uint8_t* p, uint32_t v) {
+  put16(p, v & 0xFFFF);
+  put16(p + 2, v >> 16);
+}
+
+uint16_t FlightRecorder::get16(const uint8_t* p) {
+  return p[0] | (uint16_t)p[1] << 8;
+}
+
+uint32_t FlightRecorder::get32(const uint8_t* p) {
+  return get16(p) | (uint32_t)get16(p + 2) << 16;
+}
@@ -0,0 +1,113 @@
+#ifndef FLIGHT_RECORDER_H
+#define FLIGHT_RECORDER_H
+
+#include <Arduino.h>
+
+// a command costs two records, its arrival and the drain that applied it, and
+// a motor ramp one where it starts, one per retarget on the way and one where
+// it ends; a 30 Hz slider drag keeps about 2 s, sparse driving minutes. With
+// MOTOR_ENCODERS the loop's corrections are actuator changes too, up to one
+// per motor tick. -DFLIGHT_RECORDER_SIZE=N keeps more, at 16 bytes of RAM each
+#ifndef FLIGHT_RECORDER_SIZE
+#define FLIGHT_RECORDER_SIZE 256 // records, 16 bytes each
+#endif
+
+/*
+  Last FLIGHT_RECORDER_SIZE commands and actuator states, in RAM, oldest
+  overwritten first. Dumped as (little-endian):
+
+    header, 16 bytes
+      0  magic      "RCFR"
+      4  version    FLIGHT_RECORDER_VERSION
+      5  recordSize sizeof(Record)
+      6  count      records that follow, uint16
+      8  total      records written since boot, uint32 (total - count were lost)
+      12 nowUs      micros() at the dump, uint32
+    count records, oldest first
+      0  us         micros() when it happened, uint32 (wraps)
+      4  type       Type
+      5  source     Source
+      6  seq        ControlFrame sequence, 0 for other commands
+      8  a, b, c, d int16 each, see Type
+*/
+#define FLIGHT_RECORDER_VERSION 1
+
+class FlightRecorder {
+  public:
+    enum Type : uint8_t {
+      CMD_SPEED = 1, // a = throttle
+      CMD_DIR,       // a = direction
+      CMD_STEER,     // a = angle, degrees
+      CMD_MODE,      // a = DriveMixer::Mode
+      CMD_TANK,      // a = left, b = right
+      CMD_HEARTBEAT,
+      CMD_ARM,
+      CMD_CONTROL,   // seq, a = throttle, b = direction, c = steering,
+                     // d = flags | channel << 8
+      EVENT_LINK,    // a = 1 up, 0 down
+      EVENT_TRIP,    // failsafe tripped
+      ACTUATORS,     // a = left PWM, b = right PWM, c = servo us, d = failsafe state
+      EVENT_DRAIN    // queued commands applied: a = us after the cycle's tick,
+                     // b, c = tick's scheduler slot, low and high half, d = applied
+    };
+
+    enum Source : uint8_t {
+      SOURCE_SELF = 0, // the car's own events
+      SOURCE_WEB,      // HTTP or WebSocket
+      SOURCE_UDP
+    };
+
+    struct Record {
+      uint32_t us;
+      uint8_t type;
+      uint8_t source;
+      uint16_t seq;
+      int16_t a;
+      int16_t b;
+      int16_t c;
+      int16_t d;
+    };
+
+    static const size_t HEADER_SIZE = 16;
+    static const size_t RECORD_SIZE = 16;
+
+    void record(Type type, Source source, uint16_t seq = 0,
+                int16_t a = 0, int16_t b = 0, int16_t c = 0, int16_t d = 0);
+    // only when the actuator state differs from the last one recorded; while
+    // the motors ramp toward targetLeft/targetRight, only the first step, the
+    // first one after the targets change and the one reaching them
+    void recordOutput(int16_t left, int16_t right, int16_t servoUs, int16_t failsafe,
+                      bool ramping, int16_t targetLeft, int16_t targetRight);
+
+    size_t count() const;
+    uint32_t total() const;
+    const Record& at(size_t i) const; // 0 = oldest
+
+    // bytes dump() will write
+    size_t dumpSize() const;
+    size_t dump(Print& out) const;
+
+    // the other direction, for host tools; false if buf is not a dump
+    static bool parseHeader(const uint8_t* buf, size_t len, uint16_t& count, uint32_t& total);
+    static Record parseRecord(const uint8_t* buf);
+
+  private:
+    static_assert(FLIGHT_RECORDER_SIZE > 0 && FLIGHT_RECORDER_SIZE <= 0xFFFF,
+                  "the dump counts records in 16 bits");
+    Record records[FLIGHT_RECORDER_SIZE];
+    size_t head = 0; // next slot to write
+    size_t filled = 0;
+    uint32_t written = 0;
+
+    bool haveOutput = false;
+    bool lastRamping = false;
+    int16_t lastOutput[4];
+    int16_t lastTarget[2];
+
+    static void put16(uint8_t* p, uint16_t v);
+    static void put32(uint8_t* p, uint32_t v);
+    static uint16_t get16(const uint8_t* p);
+    static uint32_t get32(const uint8_t* p);
+};
+
+#endif
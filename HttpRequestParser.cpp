@@ -0,0 +1,289 @@
+#include "HttpRequestParser.h"
+
+static char lower(char c) {
+  return (c >= 'A' && c <= 'Z') ? c + ('a' - 'A') : c;
+}
+
+static int hexValue(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+static StrView view(const char* data, size_t len) {
+  StrView v;
+  v.data = data;
+  v.len = len;
+  return v;
+}
+
+static StrView trim(StrView v) {
+  while (v.len > 0 && (v.data[0] == ' ' || v.data[0] == '\t')) {
+    v.data++;
+    v.len--;
+  }
+  while (v.len > 0 && (v.data[v.len - 1] == ' ' || v.data[v.len - 1] == '\t')) v.len--;
+  return v;
+}
+
+/* ---------------------------------------------------
+   StrView
+--------------------------------------------------- */
+
+bool StrView::equals(const char* s) const {
+  size_t n = strlen(s);
+  return n == len && memcmp(data, s, n) == 0;
+}
+
+bool StrView::equalsIgnoreCase(const char* s) const {
+  size_t n = strlen(s);
+  if (n != len) return false;
+  for (size_t i = 0; i < n; ++i) {
+    if (lower(data[i]) != lower(s[i])) return false;
+  }
+  return true;
+}
+
+bool StrView::contains(const char* s) const {
+  size_t n = strlen(s);
+  if (n == 0) return true;
+  for (size_t i = 0; i + n <= len; ++i) {
+    if (memcmp(data + i, s, n) == 0) return true;
+  }
+  return false;
+}
+
+/* ---------------------------------------------------
+   Parser
+--------------------------------------------------- */
+
+HttpRequestParser::HttpRequestParser() {
+  reset();
+}
+
+void HttpRequestParser::reset() {
+  used = 0;
+  lineStart = 0;
+  bodyStart = 0;
+  contentLength = 0;
+  state = REQUEST_LINE;
+  status = 0;
+  _method = StrView();
+  _path = StrView();
+  _query = StrView();
+  headerCount = 0;
+}
+
+size_t HttpRequestParser::feed(const uint8_t* data, size_t len) {
+  size_t i = 0;
+  for (; i < len; ++i) {
+    if (state == COMPLETE || state == FAILED) break;
+    char c = (char)data[i];
+
+    if (state == BODY) {
+      buf[used++] = c; // finishHeaders() checked that the body fits
+      if (used - bodyStart == contentLength) state = COMPLETE;
+      continue;
+    }
+
+    if (c == '\r') continue;
+    if (c == '\n') {
+      processLine(lineStart, used);
+      lineStart = used;
+      continue;
+    }
+
+    if (used - lineStart >= MAX_LINE) {
+      fail(state == REQUEST_LINE ? 414 : 431);
+      break;
+    }
+    if (used >= BUFFER_SIZE) {
+      fail(431);
+      break;
+    }
+    buf[used++] = c;
+  }
+  return i;
+}
+
+bool HttpRequestParser::isStarted() const {
+  return used > 0 || state != REQUEST_LINE;
+}
+
+bool HttpRequestParser::isComplete() const {
+  return state == COMPLETE;
+}
+
+bool HttpRequestParser::hasFailed() const {
+  return state == FAILED;
+}
+
+int HttpRequestParser::errorStatus() const {
+  return status;
+}
+
+StrView HttpRequestParser::method() const {
+  return _method;
+}
+
+StrView HttpRequestParser::path() const {
+  return _path;
+}
+
+StrView HttpRequestParser::query() const {
+  return _query;
+}
+
+StrView HttpRequestParser::body() const {
+  if (state != COMPLETE) return StrView();
+  return view(buf + bodyStart, contentLength);
+}
+
+StrView HttpRequestParser::header(const char* name) const {
+  for (uint8_t i = 0; i < headerCount; ++i) {
+    if (headers[i].name.equalsIgnoreCase(name)) return headers[i].value;
+  }
+  return StrView();
+}
+
+bool HttpRequestParser::param(const char* name, char* out, size_t outSize) const {
+  StrView raw;
+  if (!findParam(body(), name, raw) && !findParam(_query, name, raw)) return false;
+  if (outSize == 0) return false;
+
+  // url-decode into the caller's buffer
+  size_t o = 0;
+  for (size_t i = 0; i < raw.len; ++i) {
+    char c = raw.data[i];
+    if (c == '+') {
+      c = ' ';
+    } else if (c == '%') {
+      int hi = (i + 1 < raw.len) ? hexValue(raw.data[i + 1]) : -1;
+      int lo = (i + 2 < raw.len) ? hexValue(raw.data[i + 2]) : -1;
+      if (hi >= 0 && lo >= 0) {
+        c = (char)((hi << 4) | lo);
+        i += 2;
+      }
+    }
+    if (o + 1 >= outSize) return false; // does not fit
+    out[o++] = c;
+  }
+  out[o] = '\0';
+  return true;
+}
+
+bool HttpRequestParser::paramInt(const char* name, long& out) const {
+  char text[12];
+  if (!param(name, text, sizeof(text)) || text[0] == '\0') return false;
+
+  char* end = nullptr;
+  long value = strtol(text, &end, 10);
+  if (*end != '\0') return false;
+  out = value;
+  return true;
+}
+
+void HttpRequestParser::fail(int code) {
+  state = FAILED;
+  status = code;
+}
+
+void HttpRequestParser::processLine(size_t start, size_t end) {
+  StrView line = view(buf + start, end - start);
+  switch (state) {
+    case REQUEST_LINE:
+      if (line.empty()) return; // stray CRLF before a request is allowed
+      parseRequestLine(line);
+      break;
+    case HEADERS:
+      if (line.empty()) {
+        finishHeaders();
+      } else {
+        parseHeaderLine(line);
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+void HttpRequestParser::parseRequestLine(StrView line) {
+  // METHOD SP target SP HTTP/1.x
+  const char* sp1 = (const char*)memchr(line.data, ' ', line.len);
+  if (!sp1) return fail(400);
+  size_t rest = line.len - (sp1 + 1 - line.data);
+  const char* sp2 = (const char*)memchr(sp1 + 1, ' ', rest);
+  if (!sp2) return fail(400);
+
+  StrView version = view(sp2 + 1, line.data + line.len - (sp2 + 1));
+  if (version.len < 8 || memcmp(version.data, "HTTP/1.", 7) != 0) return fail(400);
+
+  _method = view(line.data, sp1 - line.data);
+  StrView target = view(sp1 + 1, sp2 - (sp1 + 1));
+  if (_method.empty() || target.empty() || target.data[0] != '/') return fail(400);
+
+  const char* q = (const char*)memchr(target.data, '?', target.len);
+  if (q) {
+    _path = view(target.data, q - target.data);
+    _query = view(q + 1, target.data + target.len - (q + 1));
+  } else {
+    _path = target;
+  }
+  state = HEADERS;
+}
+
+void HttpRequestParser::parseHeaderLine(StrView line) {
+  const char* colon = (const char*)memchr(line.data, ':', line.len);
+  if (!colon || colon == line.data) return fail(400);
+
+  StrView name = view(line.data, colon - line.data);
+  StrView value = trim(view(colon + 1, line.data + line.len - (colon + 1)));
+
+  if (name.equalsIgnoreCase("Content-Length")) {
+    if (value.empty()) return fail(400);
+    size_t n = 0;
+    for (size_t i = 0; i < value.len; ++i) {
+      char c = value.data[i];
+      if (c < '0' || c > '9') return fail(400);
+      if (n > BUFFER_SIZE) return fail(413); // stop before it can overflow
+      n = n * 10 + (c - '0');
+    }
+    contentLength = n;
+  }
+
+  if (headerCount < MAX_HEADERS) {
+    headers[headerCount].name = name;
+    headers[headerCount].value = value;
+    headerCount++;
+  }
+}
+
+void HttpRequestParser::finishHeaders() {
+  if (contentLength == 0) {
+    bodyStart = used;
+    state = COMPLETE;
+    return;
+  }
+  if (contentLength > BUFFER_SIZE - used) return fail(413);
+  bodyStart = used;
+  state = BODY;
+}
+
+bool HttpRequestParser::findParam(StrView data, const char* name, StrView& value) {
+  size_t nameLen = strlen(name);
+  size_t i = 0;
+  while (i < data.len) {
+    // one key=value pair up to the next '&'
+    const char* amp = (const char*)memchr(data.data + i, '&', data.len - i);
+    size_t end = amp ? (size_t)(amp - data.data) : data.len;
+    StrView pair = view(data.data + i, end - i);
+
+    if (pair.len > nameLen && pair.data[nameLen] == '=' && memcmp(pair.data, name, nameLen) == 0) {
+      value = view(pair.data + nameLen + 1, pair.len - nameLen - 1);
+      return true;
+    }
+    i = end + 1;
+  }
+  return false;
+}
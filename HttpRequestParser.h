@@ -0,0 +1,89 @@
+#ifndef HTTP_REQUEST_PARSER_H
+#define HTTP_REQUEST_PARSER_H
+
+#include <Arduino.h>
+
+// Non-owning view into the parser buffer
+struct StrView {
+  const char* data = nullptr;
+  size_t len = 0;
+
+  bool empty() const { return len == 0; }
+  bool equals(const char* s) const;
+  bool equalsIgnoreCase(const char* s) const;
+  bool contains(const char* s) const;
+};
+
+/*
+  Incremental HTTP/1.x request parser over a fixed buffer.
+
+  Bytes are fed as they arrive, possibly across several update() calls.
+  Method, path, query, headers and body stay in the buffer and are handed
+  out as StrViews, so nothing is allocated. Oversized input fails the
+  request with the status code to answer:
+    414  request line longer than MAX_LINE
+    431  header line longer than MAX_LINE, or headers overflow the buffer
+    413  body does not fit in what is left of the buffer
+    400  anything malformed
+*/
+class HttpRequestParser {
+  public:
+    static const size_t BUFFER_SIZE = 1024;
+    static const size_t MAX_LINE = 512;
+    static const uint8_t MAX_HEADERS = 16; // extra headers are ignored
+
+    HttpRequestParser();
+
+    void reset();
+
+    // returns how many bytes were consumed; stops once complete or failed
+    size_t feed(const uint8_t* data, size_t len);
+
+    bool isStarted() const;
+    bool isComplete() const;
+    bool hasFailed() const;
+    int errorStatus() const;
+
+    StrView method() const;
+    StrView path() const;
+    StrView query() const;
+    StrView body() const;
+    StrView header(const char* name) const;
+
+    // form field from the body, else the query string, url-decoded into out
+    bool param(const char* name, char* out, size_t outSize) const;
+    bool paramInt(const char* name, long& out) const;
+
+  private:
+    enum State { REQUEST_LINE, HEADERS, BODY, COMPLETE, FAILED };
+
+    struct Header {
+      StrView name;
+      StrView value;
+    };
+
+    char buf[BUFFER_SIZE];
+    size_t used = 0;
+    size_t lineStart = 0;
+    size_t bodyStart = 0;
+    size_t contentLength = 0;
+
+    State state = REQUEST_LINE;
+    int status = 0;
+
+    StrView _method;
+    StrView _path;
+    StrView _query;
+    Header headers[MAX_HEADERS];
+    uint8_t headerCount = 0;
+
+    void fail(int code);
+    void processLine(size_t start, size_t end);
+    void parseRequestLine(StrView line);
+    void parseHeaderLine(StrView line);
+    void finishHeaders();
+
+    static bool findParam(StrView data, const char* name, StrView& value);
+};
+
+#endif
@@ -0,0 +1,62 @@
+#include "LatencyHistogram.h"
+
+static uint8_t bucketOf(uint32_t us) {
+  if (us == 0) return 0;
+  uint8_t b = 32 - __builtin_clz(us); // bit length
+  return b < LatencyHistogram::BUCKETS ? b : LatencyHistogram::BUCKETS - 1;
+}
+
+void LatencyHistogram::record(uint32_t us) {
+  buckets[bucketOf(us)]++;
+  if (samples == 0 || us < lo) lo = us;
+  if (us > hi) hi = us;
+  samples++;
+  sum += us;
+}
+
+void LatencyHistogram::reset() {
+  *this = LatencyHistogram();
+}
+
+uint32_t LatencyHistogram::count() const {
+  return samples;
+}
+
+uint32_t LatencyHistogram::minimum() const {
+  return lo;
+}
+
+uint32_t LatencyHistogram::maximum() const {
+  return hi;
+}
+
+uint32_t LatencyHistogram::mean() const {
+  return samples ? (uint32_t)(sum / samples) : 0;
+}
+
+uint32_t LatencyHistogram::percentile(uint8_t pct) const {
+  if (samples == 0) return 0;
+
+  // rank of the sample we want, 1-based and rounded up
+  uint32_t rank = (uint32_t)(((uint64_t)samples * pct + 99) / 100);
+  if (rank == 0) rank = 1;
+
+  uint32_t seen = 0;
+  for (uint8_t b = 0; b < BUCKETS; ++b) {
+    seen += buckets[b];
+    if (seen < rank) continue;
+    uint32_t edge = b == 0 ? 0 : ((1UL << b) - 1);
+    if (edge < lo) edge = lo;
+    return edge < hi ? edge : hi;
+  }
+  return hi;
+}
+
+size_t LatencyHistogram::format(char* out, size_t size) const {
+  int n = snprintf(out, size, "n=%lu min=%lu p50=%lu p99=%lu max=%lu",
+                   (unsigned long)samples, (unsigned long)lo,
+                   (unsigned long)percentile(50), (unsigned long)percentile(99),
+                   (unsigned long)hi);
+  if (n < 0) return 0;
+  return (size_t)n < size ? n : size - 1;
+}
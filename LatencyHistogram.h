@@ -0,0 +1,34 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <Arduino.h>
+
+// Log2-bucketed microsecond histogram: fixed size, O(1) record, no floats.
+// Bucket i counts samples in [2^(i-1), 2^i), bucket 0 counts zeros, the
+// last one everything from ~1 s up.
+class LatencyHistogram {
+  public:
+    static const uint8_t BUCKETS = 22;
+
+    void record(uint32_t us);
+    void reset();
+
+    uint32_t count() const;
+    uint32_t minimum() const;
+    uint32_t maximum() const;
+    uint32_t mean() const;
+    // upper edge of the bucket holding the given percentile, capped at maximum()
+    uint32_t percentile(uint8_t pct) const;
+
+    // "n=.. min=.. p50=.. p99=.. max=.." into out, returns chars written
+    size_t format(char* out, size_t size) const;
+
+  private:
+    uint32_t buckets[BUCKETS] = {};
+    uint32_t samples = 0;
+    uint32_t lo = 0;
+    uint32_t hi = 0;
+    uint64_t sum = 0;
+};
+
+#endif
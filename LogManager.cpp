@@ -0,0 +1,110 @@
+#include "LogManager.h"
+
+static const uint8_t QUEUE_MASK = LOG_QUEUE_SIZE - 1;
+static_assert((LOG_QUEUE_SIZE & QUEUE_MASK) == 0 && LOG_QUEUE_SIZE <= 128,
+              "LOG_QUEUE_SIZE must be a power of two up to 128");
+
+LogManager& LogManager::instance() {
+  static LogManager inst;
+  return inst;
+}
+
+void LogManager::init() {
+  // with the TX buffer drained, a core that tracks it reports room; one
+  // that keeps Print's default never does
+  Serial.flush();
+  txRoomKnown = Serial.availableForWrite() > 0;
+  initialized = true;
+}
+
+void LogManager::update(unsigned long now) {
+  // a handful of lines per pass, and only what the TX buffer has room for
+  blindRoom = BLIND_BYTES_PER_UPDATE;
+  for (uint8_t i = 0; i < LINES_PER_UPDATE; ++i) {
+    if (!writeLine(false)) return;
+    if (!nextLine()) return;
+  }
+}
+
+void LogManager::flush() {
+  do {
+    writeLine(true);
+  } while (nextLine());
+  Serial.flush();
+}
+
+void LogManager::push(Level level, const char* fmt, uint8_t argc, const long* args) {
+  uint8_t h = head;
+  if (((h + 1) & QUEUE_MASK) == tail) {
+    dropped++;
+    return;
+  }
+
+  Entry& e = queue[h];
+  e.ms = millis();
+  e.fmt = fmt;
+  e.level = level;
+  e.argc = argc;
+  for (uint8_t i = 0; i < argc; ++i) e.args[i] = args[i];
+
+  __sync_synchronize(); // entry is complete before the consumer can see it
+  head = (h + 1) & QUEUE_MASK;
+}
+
+uint32_t LogManager::getDropped() const {
+  return dropped;
+}
+
+uint8_t LogManager::getQueued() const {
+  return (head - tail) & QUEUE_MASK;
+}
+
+bool LogManager::nextLine() {
+  lineLen = linePos = 0;
+
+  // report losses in order, before the first message that made it through
+  if (dropped != droppedReported) {
+    uint32_t lost = dropped - droppedReported;
+    droppedReported += lost;
+    int n = snprintf(line, LINE_SIZE, "%lu W <log> %lu messages dropped\r\n",
+                     (unsigned long)millis(), (unsigned long)lost);
+    lineLen = n < LINE_SIZE ? n : LINE_SIZE - 1;
+    return true;
+  }
+
+  uint8_t t = tail;
+  if (t == head) return false;
+
+  __sync_synchronize();
+  const Entry& e = queue[t];
+  static const char LEVEL_CHARS[] = "?EWID";
+
+  int n = snprintf(line, LINE_SIZE, "%lu %c ", (unsigned long)e.ms, LEVEL_CHARS[e.level]);
+  if (n < 0) n = 0;
+  long a[MAX_ARGS] = {0, 0, 0, 0};
+  for (uint8_t i = 0; i < e.argc; ++i) a[i] = e.args[i];
+  int m = snprintf(line + n, LINE_SIZE - n - 2, e.fmt, a[0], a[1], a[2], a[3]);
+  if (m > 0) n += m < LINE_SIZE - n - 2 ? m : LINE_SIZE - n - 3;
+
+  tail = (t + 1) & QUEUE_MASK;
+
+  line[n++] = '\r';
+  line[n++] = '\n';
+  lineLen = n;
+  return true;
+}
+
+bool LogManager::writeLine(bool block) {
+  while (linePos < lineLen) {
+    int room = block ? lineLen - linePos : (txRoomKnown ? Serial.availableForWrite() : blindRoom);
+    if (room <= 0) return false;
+
+    uint8_t len = lineLen - linePos;
+    if (room < len) len = room;
+    size_t written = Serial.write((const uint8_t*)line + linePos, len);
+    if (written == 0) return false;
+    linePos += written;
+    if (!block && !txRoomKnown) blindRoom -= written;
+  }
+  return true;
+}
@@ -0,0 +1,114 @@
+#ifndef LOG_MANAGER_H
+#define LOG_MANAGER_H
+
+#include <Arduino.h>
+#include "BasicManager.h"
+
+#define LOG_LEVEL_NONE  0
+#define LOG_LEVEL_ERROR 1
+#define LOG_LEVEL_WARN  2
+#define LOG_LEVEL_INFO  3
+#define LOG_LEVEL_DEBUG 4
+
+// levels above this compile out entirely, arguments included
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_INFO
+#endif
+
+#ifndef LOG_QUEUE_SIZE
+#define LOG_QUEUE_SIZE 32 // entries, power of two
+#endif
+
+// Deferred logging: the call site only stores the format pointer and up to
+// four integer arguments; the text is formatted when the queue is drained,
+// and only as fast as the UART takes it. A full queue drops and counts.
+//
+// fmt must be a string literal and arguments integers, printed with %ld/%lu/%lx.
+class LogManager : public BasicManager {
+  public:
+    enum Level : uint8_t {LEVEL_ERROR = LOG_LEVEL_ERROR, LEVEL_WARN, LEVEL_INFO, LEVEL_DEBUG};
+    static const uint8_t MAX_ARGS = 4;
+
+    static LogManager& instance();
+
+    void init() override;
+    void update(unsigned long now) override; // drains without blocking
+
+    // blocks until everything queued is on the wire (boot, fatal paths)
+    void flush();
+
+    template <typename... Args>
+    void write(Level level, const char* fmt, Args... args) {
+      static_assert(sizeof...(Args) <= MAX_ARGS, "too many log arguments");
+      long values[] = {0, static_cast<long>(args)...};
+      push(level, fmt, sizeof...(Args), values + 1);
+    }
+
+    uint32_t getDropped() const;
+    uint8_t getQueued() const;
+
+  private:
+    struct Entry {
+      uint32_t ms;
+      const char* fmt;
+      Level level;
+      uint8_t argc;
+      long args[MAX_ARGS];
+    };
+
+    static const uint8_t LINE_SIZE = 120;
+    static const uint8_t LINES_PER_UPDATE = 4;
+    // per update when the core can't tell the TX room: about 1.4 ms at
+    // 115200 baud should a write of it block
+    static const uint8_t BLIND_BYTES_PER_UPDATE = 16;
+
+    // single producer (the loop) / single consumer (update), no locking needed
+    Entry queue[LOG_QUEUE_SIZE];
+    volatile uint8_t head = 0; // next slot to write
+    volatile uint8_t tail = 0; // next slot to read
+
+    uint32_t dropped = 0;
+    uint32_t droppedReported = 0;
+
+    // line being written out, possibly across several updates
+    char line[LINE_SIZE];
+    uint8_t lineLen = 0;
+    uint8_t linePos = 0;
+
+    // whether Serial.availableForWrite() means anything; Print's default
+    // says 0 forever
+    bool txRoomKnown = false;
+    uint8_t blindRoom = 0;
+
+    LogManager() {}
+
+    void push(Level level, const char* fmt, uint8_t argc, const long* args);
+    bool nextLine();
+    bool writeLine(bool block);
+};
+
+#if LOG_LEVEL >= LOG_LEVEL_ERROR
+#define LOG_ERROR(...) LogManager::instance().write(LogManager::LEVEL_ERROR, __VA_ARGS__)
+#else
+#define LOG_ERROR(...) do {} while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_WARN
+#define LOG_WARN(...) LogManager::instance().write(LogManager::LEVEL_WARN, __VA_ARGS__)
+#else
+#define LOG_WARN(...) do {} while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_INFO
+#define LOG_INFO(...) LogManager::instance().write(LogManager::LEVEL_INFO, __VA_ARGS__)
+#else
+#define LOG_INFO(...) do {} while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(...) LogManager::instance().write(LogManager::LEVEL_DEBUG, __VA_ARGS__)
+#else
+#define LOG_DEBUG(...) do {} while (0)
+#endif
+
+#endif
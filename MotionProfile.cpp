@@ -0,0 +1,101 @@
+#include "MotionProfile.h"
+
+static uint32_t isqrt(uint32_t n) {
+  uint32_t root = 0;
+  uint32_t bit = 1UL << 30;
+  while (bit > n) bit >>= 2;
+  while (bit) {
+    if (n >= root + bit) {
+      n -= root + bit;
+      root = (root >> 1) + bit;
+    } else {
+      root >>= 1;
+    }
+    bit >>= 2;
+  }
+  return root;
+}
+
+void MotionProfile::setLimits(const Limits& l) {
+  limits = l;
+}
+
+const MotionProfile::Limits& MotionProfile::getLimits() const {
+  return limits;
+}
+
+int16_t MotionProfile::step(int16_t target, uint32_t nowUs) {
+  uint32_t dtUs = started ? nowUs - lastUs : 0;
+  if (dtUs > MAX_STEP_US) dtUs = MAX_STEP_US;
+  started = true;
+  lastUs = nowUs;
+
+  target = constrain(target, -255, 255);
+  int32_t goal = (int32_t)target << FRAC_BITS;
+  int8_t goalSign = (goal > 0) - (goal < 0);
+
+  // reversing: come down to zero and sit there before going the other way
+  dwelling = false;
+  if (goalSign != 0 && lastSign != 0 && goalSign != lastSign) {
+    if (value != 0) {
+      goal = 0;
+    } else if (nowUs - zeroSinceUs < (uint32_t)limits.reverseDwellMs * 1000UL) {
+      dwelling = true;
+      return 0;
+    }
+  }
+
+  int32_t remaining = goal - value;
+  if (remaining == 0) {
+    rate = 0;
+    return output();
+  }
+
+  // goal and value never have opposite signs here
+  bool speedingUp = abs(goal) > abs(value);
+  uint32_t slew = slewLimit(remaining, speedingUp, dtUs);
+
+  // PWM/s -> (PWM << 8)/us, 1e6 / 256 = 3906.25
+  uint32_t delta = slew == 0 ? (uint32_t)abs(remaining) : (uint32_t)((uint64_t)slew * dtUs / 3906);
+  int32_t prev = value;
+  if ((uint32_t)abs(remaining) <= delta) value = goal;
+  else value += remaining > 0 ? (int32_t)delta : -(int32_t)delta;
+
+  if (value != 0) lastSign = value > 0 ? 1 : -1;
+  else if (prev != 0) zeroSinceUs = nowUs;
+  return output();
+}
+
+void MotionProfile::stop(uint32_t nowUs) {
+  if (value != 0) zeroSinceUs = nowUs;
+  value = 0;
+  rate = 0;
+}
+
+int16_t MotionProfile::output() const {
+  // round to the nearest PWM step, symmetric around zero
+  int32_t half = 1 << (FRAC_BITS - 1);
+  return value >= 0 ? (value + half) >> FRAC_BITS : -((-value + half) >> FRAC_BITS);
+}
+
+bool MotionProfile::isDwelling() const {
+  return dwelling;
+}
+
+uint32_t MotionProfile::slewLimit(int32_t remaining, bool speedingUp, uint32_t dtUs) {
+  uint32_t limit = speedingUp ? limits.accel : limits.decel;
+  if (limit == 0) return 0; // unlimited
+  if (limits.jerk == 0) return limit;
+
+  // S-curve: the slew rate itself ramps at `jerk`...
+  uint32_t rampUp = (uint32_t)((uint64_t)limits.jerk * dtUs / 1000000UL) + 1;
+  rate += rampUp;
+  if (rate > limit) rate = limit;
+
+  // ...and eases off so we arrive with it near zero: rate^2 <= 2 * jerk * distance
+  uint32_t distance = (uint32_t)abs(remaining) >> FRAC_BITS;
+  uint32_t ease = isqrt(2UL * limits.jerk * distance);
+  if (ease < rampUp) ease = rampUp;
+  if (rate > ease) rate = ease;
+  return rate;
+}
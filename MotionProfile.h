@@ -0,0 +1,46 @@
+#ifndef MOTION_PROFILE_H
+#define MOTION_PROFILE_H
+
+#include <Arduino.h>
+
+// Rate-limited path from the current output to a signed target
+// (-255..255 PWM, negative is reverse). Evaluated in fixed point once per
+// tick: trapezoidal when jerk is 0, S-curve otherwise. A change of sign
+// ramps down to zero and holds there for reverseDwellMs first.
+class MotionProfile {
+  public:
+    struct Limits {
+      uint16_t accel = 400;          // PWM/s while speeding up
+      uint16_t decel = 800;          // PWM/s while slowing down
+      uint16_t jerk = 0;             // PWM/s^2, 0 = plain trapezoid
+      uint16_t reverseDwellMs = 150; // bridge held off before reversing
+    };
+
+    void setLimits(const Limits& limits);
+    const Limits& getLimits() const;
+
+    // advance to nowUs and return the new output
+    int16_t step(int16_t target, uint32_t nowUs);
+    // jump to zero with no ramp (e-stop); the dwell still applies after it
+    void stop(uint32_t nowUs);
+
+    int16_t output() const;
+    bool isDwelling() const;
+
+  private:
+    static const uint8_t FRAC_BITS = 8;
+    static const uint32_t MAX_STEP_US = 50000; // a stalled loop must not jump
+
+    Limits limits;
+    int32_t value = 0;       // output << FRAC_BITS
+    uint32_t rate = 0;       // present slew, PWM/s (S-curve only)
+    int8_t lastSign = 0;     // sign the output last had while nonzero
+    bool dwelling = false;
+    uint32_t zeroSinceUs = 0;
+    uint32_t lastUs = 0;
+    bool started = false;
+
+    uint32_t slewLimit(int32_t remaining, bool speedingUp, uint32_t dtUs);
+};
+
+#endif
@@ -1,16 +1,36 @@
 #include "MotorManager.h"
+#include "LogManager.h"
+
+#if defined(MOTOR_ENCODERS)
+// pin interrupts can't carry a this pointer
+static WheelEncoder* isrEncoders[2];
+static void onLeftEdge() { isrEncoders[MotorManager::CHANNEL_LEFT]->onEdge(micros()); }
+static void onRightEdge() { isrEncoders[MotorManager::CHANNEL_RIGHT]->onEdge(micros()); }
+#endif
 
 void MotorManager::init() {
   max_output = 200;
   direction = STOP;
 
   // pinMode setting
-  pinMode(IN1, OUTPUT);
-  pinMode(IN2, OUTPUT);
-  pinMode(ENA, OUTPUT);
-  pinMode(IN3, OUTPUT);
-  pinMode(IN4, OUTPUT);
-  pinMode(ENB, OUTPUT);
+  for (Channel& ch : channels) {
+    pinMode(ch.in1, OUTPUT);
+    pinMode(ch.in2, OUTPUT);
+    pinMode(ch.en, OUTPUT);
+    ch.known = false;
+#if defined(MOTOR_FAST_GPIO) && defined(ARDUINO_ARCH_RENESAS)
+    initFastPin(ch.fast1, ch.in1);
+    initFastPin(ch.fast2, ch.in2);
+#endif
+  }
+
+#if defined(MOTOR_ENCODERS)
+  isrEncoders[CHANNEL_LEFT] = &channels[CHANNEL_LEFT].encoder;
+  isrEncoders[CHANNEL_RIGHT] = &channels[CHANNEL_RIGHT].encoder;
+  channels[CHANNEL_LEFT].encoder.begin(ENCODER_PIN_LEFT, onLeftEdge);
+  channels[CHANNEL_RIGHT].encoder.begin(ENCODER_PIN_RIGHT, onRightEdge);
+  lastLoopUs = micros();
+#endif
 
   // ensure MotorManager is initialized
   initialized = true;
@@ -28,8 +48,104 @@ void MotorManager::setMaxOutput(uint8_t rate) {
 
 void MotorManager::setDirection(MotorManager::Direction dir) {
   direction = dir;
+  if (dir == STOP) tankActive = false;
+}
+
+void MotorManager::emergencyStop() {
+  direction = STOP;
+  tankActive = false;
+  tankLeft = tankRight = 0;
+  uint32_t nowUs = micros();
+  for (Channel& ch : channels) {
+    ch.profile.stop(nowUs);
+#if defined(MOTOR_ENCODERS)
+    ch.loop.reset();
+#endif
+  }
+  if (initialized) applyMotorOutput();
+}
+
+void MotorManager::setDriveMode(DriveMixer::Mode mode) {
+  if (mode >= DriveMixer::MODE_COUNT) return;
+  // tank targets never carry over into another mode
+  if (mode != DriveMixer::TANK) tankActive = false;
+  driveMode = mode;
+}
+
+DriveMixer::Mode MotorManager::getDriveMode() const {
+  return driveMode;
+}
+
+void MotorManager::setSteering(int8_t s) {
+  steering = constrain(s, -100, 100);
+}
+
+bool MotorManager::setTank(int16_t left, int16_t right) {
+  if (driveMode != DriveMixer::TANK) return false;
+  tankLeft = constrain(left, -255, 255);
+  tankRight = constrain(right, -255, 255);
+  tankActive = true;
+  return true;
+}
+
+bool MotorManager::isTankActive() const {
+  return tankActive;
+}
+
+void MotorManager::setProfileLimits(const MotionProfile::Limits& limits) {
+  for (Channel& ch : channels) ch.profile.setLimits(limits);
+}
+
+const MotionProfile::Limits& MotorManager::getProfileLimits() const {
+  return channels[0].profile.getLimits();
+}
+
+int16_t MotorManager::getAppliedOutput(uint8_t channel) const {
+  if (channel >= 2) return 0;
+  const Channel& ch = channels[channel];
+  return ch.dir == BACKWARD ? -(int16_t)ch.speed : (ch.dir == FORWARD ? ch.speed : 0);
+}
+
+int16_t MotorManager::getOutputTarget(uint8_t channel) const {
+  if (channel >= 2) return 0;
+  return channels[channel].target;
+}
+
+bool MotorManager::isRamping() const {
+  for (const Channel& ch : channels) {
+    if (ch.profile.output() != ch.target) return true;
+  }
+  return false;
+}
+
+#if defined(MOTOR_ENCODERS)
+bool MotorManager::hasEncoders() const {
+  return true;
+}
+
+int16_t MotorManager::getSpeedSetpoint(uint8_t channel) const {
+  return channel < 2 ? channels[channel].setpoint : 0;
+}
+
+int16_t MotorManager::getMeasuredSpeed(uint8_t channel) const {
+  return channel < 2 ? channels[channel].measured : 0;
 }
 
+bool MotorManager::hasEncoderFault(uint8_t channel) const {
+  return channel < 2 && channels[channel].fault;
+}
+
+void MotorManager::setSpeedGains(const SpeedController::Gains& gains) {
+  for (Channel& ch : channels) ch.loop.setGains(gains);
+}
+#else
+bool MotorManager::hasEncoders() const { return false; }
+int16_t MotorManager::getSpeedSetpoint(uint8_t) const { return 0; }
+int16_t MotorManager::getMeasuredSpeed(uint8_t) const { return 0; }
+bool MotorManager::hasEncoderFault(uint8_t) const { return false; }
+void MotorManager::setSpeedGains(const SpeedController::Gains&) {}
+#endif
+
 uint8_t MotorManager::getMaxOutput() const {
   return max_output;
 }
@@ -38,31 +154,137 @@ MotorManager::Direction MotorManager::getDirection() const {
   return direction;
 }
 
+void MotorManager::stampCommand(uint32_t us) {
+  // keep the oldest unapplied one, that's the delay the driver feels
+  if (commandPending) return;
+  commandStampUs = us;
+  commandPending = true;
+}
+
+const LatencyHistogram& MotorManager::getCommandLatency() const {
+  return commandLatency;
+}
+
+uint32_t MotorManager::getWritesIssued() const {
+  return writesIssued;
+}
+
+uint32_t MotorManager::getWritesElided() const {
+  return writesElided;
+}
+
 void MotorManager::applyMotorOutput() {
-  uint8_t speed = max_output;
-  Serial.print("<MotorManager log> speed: ");
-  Serial.print(speed);
-  Serial.print(" direction: ");
-  Serial.println(direction);
-
-  setMotor(IN1, IN2, ENA, speed);
-  setMotor(IN3, IN4, ENB, speed);
-}
-
-void MotorManager::setMotor(uint8_t in1, uint8_t in2, uint8_t en, uint8_t speed) {
-  switch (direction) {
-    case STOP:
-      digitalWrite(in1, LOW);
-      digitalWrite(in2, LOW);
-      break;
-    case FORWARD:
-      digitalWrite(in1, HIGH);
-      digitalWrite(in2, LOW);
-      break;
-    case BACKWARD:
-      digitalWrite(in1, LOW);
-      digitalWrite(in2, HIGH);
-      break;
+  int16_t left = 0;
+  int16_t right = 0;
+  if (driveMode == DriveMixer::TANK) {
+    if (tankActive) {
+      left = tankLeft;
+      right = tankRight;
+    }
+  } else if (direction != STOP) {
+    int16_t throttle = direction == BACKWARD ? -max_output : max_output;
+    DriveMixer::mix(driveMode, throttle, steering, left, right);
+  }
+
+  channels[CHANNEL_LEFT].target = left;
+  channels[CHANNEL_RIGHT].target = right;
+
+  uint32_t nowUs = micros();
+#if defined(MOTOR_ENCODERS)
+  // runs at the motor task's fixed rate; dt is measured anyway
+  uint32_t dtUs = nowUs - lastLoopUs;
+  lastLoopUs = nowUs;
+  setMotor(channels[CHANNEL_LEFT], closeLoop(channels[CHANNEL_LEFT], channels[CHANNEL_LEFT].profile.step(left, nowUs), nowUs, dtUs));
+  setMotor(channels[CHANNEL_RIGHT], closeLoop(channels[CHANNEL_RIGHT], channels[CHANNEL_RIGHT].profile.step(right, nowUs), nowUs, dtUs));
+#else
+  setMotor(channels[CHANNEL_LEFT], channels[CHANNEL_LEFT].profile.step(left, nowUs));
+  setMotor(channels[CHANNEL_RIGHT], channels[CHANNEL_RIGHT].profile.step(right, nowUs));
+#endif
+
+  if (commandPending) {
+    commandLatency.record(micros() - commandStampUs);
+    commandPending = false;
+  }
+}
+
+#if defined(MOTOR_ENCODERS)
+int16_t MotorManager::closeLoop(Channel& ch, int16_t target, uint32_t nowUs, uint32_t dtUs) {
+  // the ramped target, read as a fraction of full speed
+  ch.setpoint = (int32_t)target * MAX_SPEED_MMPS / 255;
+  int16_t speed = ch.encoder.sample(nowUs);
+  ch.measured = ch.setpoint < 0 ? -speed : speed;
+  if (ch.fault) return target;
+
+  int16_t out = ch.loop.step(ch.setpoint, ch.measured, dtUs);
+
+  // pushing hard with nothing turning: don't wind the output up on a dead sensor
+  unsigned long nowMs = millis();
+  if (speed != 0 || abs(out) < FAULT_PWM) {
+    ch.silentSinceMs = nowMs;
+  } else if (nowMs - ch.silentSinceMs > FAULT_MS) {
+    ch.fault = true;
+    ch.loop.reset();
+    LOG_WARN("<MotorManager log> encoder on pin %ld silent, open loop", ch.en);
+    return target;
   }
-  analogWrite(en, speed);
-}
\ No newline at end of file
+  return out;
+}
+#endif
+
+void MotorManager::setMotor(Channel& ch, int16_t out) {
+  Direction dir = out > 0 ? FORWARD : (out < 0 ? BACKWARD : STOP);
+  uint8_t speed = out < 0 ? -out : out;
+
+  // only touch the pins whose value actually changes
+  if (!ch.known || ch.dir != dir) {
+    switch (dir) {
+      case STOP:
+        writeDirPins(ch, LOW, LOW);
+        break;
+      case FORWARD:
+        writeDirPins(ch, HIGH, LOW);
+        break;
+      case BACKWARD:
+        writeDirPins(ch, LOW, HIGH);
+        break;
+    }
+    LOG_DEBUG("<MotorManager log> pin %ld direction: %ld", ch.en, dir);
+  } else {
+    writesElided += 2;
+  }
+
+  if (!ch.known || ch.speed != speed) {
+    analogWrite(ch.en, speed);
+    writesIssued++;
+    LOG_DEBUG("<MotorManager log> pin %ld speed: %ld", ch.en, speed);
+  } else {
+    writesElided++;
+  }
+
+  ch.dir = dir;
+  ch.speed = speed;
+  ch.known = true;
+}
+
+#if defined(MOTOR_FAST_GPIO) && defined(ARDUINO_ARCH_RENESAS)
+void MotorManager::initFastPin(FastPin& f, uint8_t pin) {
+  bsp_io_port_pin_t p = g_pin_cfg[pin].pin;
+  uintptr_t stride = (uintptr_t)R_PORT1 - (uintptr_t)R_PORT0;
+  R_PORT0_Type* port = (R_PORT0_Type*)((uintptr_t)R_PORT0 + (p >> 8) * stride);
+  f.reg = &port->PCNTR3;
+  f.mask = 1UL << (p & 0xFF);
+}
+
+void MotorManager::writeDirPins(Channel& ch, uint8_t level1, uint8_t level2) {
+  // one store per pin, no pin table lookup
+  *ch.fast1.reg = level1 ? ch.fast1.mask : ch.fast1.mask << 16;
+  *ch.fast2.reg = level2 ? ch.fast2.mask : ch.fast2.mask << 16;
+  writesIssued += 2;
+}
+#else
+void MotorManager::writeDirPins(Channel& ch, uint8_t level1, uint8_t level2) {
+  digitalWrite(ch.in1, level1);
+  digitalWrite(ch.in2, level2);
+  writesIssued += 2;
+}
+#endif
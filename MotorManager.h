@@ -2,35 +2,135 @@
 #define MOTOR_MANAGER_H
 
 #include "BasicManager.h"
+#include "LatencyHistogram.h"
+#include "MotionProfile.h"
+#include "DriveMixer.h"
+#include "WheelEncoder.h"
+#include "SpeedController.h"
 #include <Arduino.h>
 
 class MotorManager : public BasicManager {
   public:
     enum Direction {FORWARD = 0, BACKWARD, STOP};
+    static const uint8_t CHANNEL_LEFT = 0;  // IN1/IN2/ENA
+    static const uint8_t CHANNEL_RIGHT = 1; // IN3/IN4/ENB
+
+    // -DMOTOR_ENCODERS: a wheel encoder on each channel closes the loop, and
+    // channel targets become wheel speeds, full scale = MAX_SPEED_MMPS
+    static const uint8_t ENCODER_PIN_LEFT = A1;
+    static const uint8_t ENCODER_PIN_RIGHT = A2;
+    static const int16_t MAX_SPEED_MMPS = 1000;
 
     void init() override;
     void update(unsigned long now) override;
     
+    // commanded speed and direction; the bridge ramps there (see MotionProfile)
     void setMaxOutput(uint8_t rate);
     void setDirection(Direction dir);
-    
+    // cut the output right now, no ramp down
+    void emergencyStop();
+
     uint8_t getMaxOutput() const;
     Direction getDirection() const;
 
+    // how throttle (speed + direction) and steering split across the channels
+    void setDriveMode(DriveMixer::Mode mode);
+    DriveMixer::Mode getDriveMode() const;
+    void setSteering(int8_t steering);
+    // TANK mode only: per-side targets, -255..255, driven until a STOP or a
+    // mode change; false (and ignored) in any other mode
+    bool setTank(int16_t left, int16_t right);
+    bool isTankActive() const;
+
+    // applies to both channels
+    void setProfileLimits(const MotionProfile::Limits& limits);
+    const MotionProfile::Limits& getProfileLimits() const;
+    int16_t getAppliedOutput(uint8_t channel) const; // signed PWM actually on the bridge
+    int16_t getOutputTarget(uint8_t channel) const; // signed PWM the profile ramps toward
+    bool isRamping() const; // a channel's profile hasn't reached its target yet
+
+    // closed loop; all zero / false when built without MOTOR_ENCODERS
+    bool hasEncoders() const;
+    int16_t getSpeedSetpoint(uint8_t channel) const; // mm/s
+    int16_t getMeasuredSpeed(uint8_t channel) const; // mm/s, signed like the output
+    bool hasEncoderFault(uint8_t channel) const;
+    void setSpeedGains(const SpeedController::Gains& gains);
+
+    // time a command arrived; the next output write records the delay
+    void stampCommand(uint32_t us);
+    const LatencyHistogram& getCommandLatency() const;
+
+    // pin writes issued / skipped because the pin already had that value
+    uint32_t getWritesIssued() const;
+    uint32_t getWritesElided() const;
+
   private:
-    const uint8_t IN1 = 2;
-    const uint8_t IN2 = 3;
-    const uint8_t ENA = 5;
-    
-    const uint8_t IN3 = 7;
-    const uint8_t IN4 = 8;
-    const uint8_t ENB = 9;
+#if defined(MOTOR_FAST_GPIO) && defined(ARDUINO_ARCH_RENESAS)
+    // opt-in (-DMOTOR_FAST_GPIO): direction pins written straight to the
+    // port registers instead of through digitalWrite
+    struct FastPin {
+      volatile uint32_t* reg = nullptr; // PCNTR3: low half sets, high half resets
+      uint32_t mask = 0;
+    };
+#endif
+
+    // one H-bridge side, its ramp and what was last written to it
+    struct Channel {
+      Channel(uint8_t in1, uint8_t in2, uint8_t en) : in1(in1), in2(in2), en(en) {}
+
+      uint8_t in1;
+      uint8_t in2;
+      uint8_t en;
+      MotionProfile profile;
+      int16_t target = 0; // what the profile was last stepped toward
+      bool known = false; // false until the first write, forces it through
+      Direction dir = STOP;
+      uint8_t speed = 0;
+#if defined(MOTOR_FAST_GPIO) && defined(ARDUINO_ARCH_RENESAS)
+      FastPin fast1;
+      FastPin fast2;
+#endif
+#if defined(MOTOR_ENCODERS)
+      WheelEncoder encoder;
+      SpeedController loop;
+      int16_t setpoint = 0; // mm/s
+      int16_t measured = 0; // mm/s
+      bool fault = false;   // encoder silent under power; open loop from then on
+      unsigned long silentSinceMs = 0;
+#endif
+    };
+    Channel channels[2] = {{2, 3, 5}, {7, 8, 9}};
+
+    uint32_t writesIssued = 0;
+    uint32_t writesElided = 0;
 
     uint8_t max_output = 0;
     Direction direction = STOP;
+    DriveMixer::Mode driveMode = DriveMixer::SERVO_ONLY;
+    int8_t steering = 0;
+    int16_t tankLeft = 0;
+    int16_t tankRight = 0;
+    bool tankActive = false; // tank targets live; direction stays as commanded
+
+    uint32_t commandStampUs = 0;
+    bool commandPending = false;
+    LatencyHistogram commandLatency;
+
+#if defined(MOTOR_ENCODERS)
+    // a channel driven this hard that shows no motion for this long has lost its encoder
+    static const uint8_t FAULT_PWM = 200;
+    static const unsigned long FAULT_MS = 500;
+    uint32_t lastLoopUs = 0;
+
+    int16_t closeLoop(Channel& ch, int16_t target, uint32_t nowUs, uint32_t dtUs);
+#endif
 
     void applyMotorOutput();
-    void setMotor(uint8_t in1, uint8_t in2, uint8_t en, uint8_t speed);
+    void setMotor(Channel& ch, int16_t out);
+    void writeDirPins(Channel& ch, uint8_t level1, uint8_t level2);
+#if defined(MOTOR_FAST_GPIO) && defined(ARDUINO_ARCH_RENESAS)
+    void initFastPin(FastPin& f, uint8_t pin);
+#endif
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,134 @@
+#ifndef ROUTE_TABLE_H
+#define ROUTE_TABLE_H
+
+#include <Arduino.h>
+#include "HttpRequestParser.h"
+
+/*
+  Declarative HTTP routes: (method, path) -> handler, plus the integer
+  parameters the handler takes and their valid ranges.
+
+  Tables are constexpr. The routing index, a perfect hash of method and path
+  into ROUTE_SLOTS, is built from the table at compile time by trying hash
+  seeds until no two routes share a slot; the build fails if none does.
+  Dispatch is one hash over the request path, one slot read and one
+  compare, however many routes there are.
+*/
+
+enum RouteMethod : uint8_t {
+  ROUTE_GET = 0,
+  ROUTE_POST,
+  ROUTE_OTHER
+};
+
+static const uint8_t MAX_ROUTE_PARAMS = 5;
+static const uint8_t ROUTE_SLOT_BITS = 5;
+static const uint8_t ROUTE_SLOTS = 1 << ROUTE_SLOT_BITS;
+static const uint8_t NO_ROUTE = 0xFF;
+static const uint16_t MAX_ROUTE_SEEDS = 1024;
+
+struct RouteParam {
+  const char* name;    // nullptr ends the list
+  long min;
+  long max;
+  bool required;
+  bool clamp;          // out of range is clamped instead of refused
+  long fallback;       // value when optional and absent
+};
+
+// handlers get the parameters in schema order, already validated
+template <typename Handler>
+struct Route {
+  RouteMethod method;
+  const char* path;
+  Handler handler;
+  RouteParam params[MAX_ROUTE_PARAMS];
+};
+
+// FNV-1a over the seed, the method and the path; the slot comes from the
+// top bits, the low ones only mix the low bits of each character
+constexpr uint32_t routeHashStep(uint32_t h, uint8_t c) {
+  return (h ^ c) * 16777619u;
+}
+
+constexpr uint8_t routeSlot(uint32_t h) {
+  return h >> (32 - ROUTE_SLOT_BITS);
+}
+
+constexpr uint8_t routeSlot(uint16_t seed, RouteMethod method, const char* path) {
+  uint32_t h = routeHashStep(routeHashStep(2166136261u ^ seed, seed >> 8), method);
+  while (*path) h = routeHashStep(h, *path++);
+  return routeSlot(h);
+}
+
+inline uint8_t routeSlot(uint16_t seed, RouteMethod method, StrView path) {
+  uint32_t h = routeHashStep(routeHashStep(2166136261u ^ seed, seed >> 8), method);
+  for (size_t i = 0; i < path.len; ++i) h = routeHashStep(h, path.data[i]);
+  return routeSlot(h);
+}
+
+inline RouteMethod routeMethod(StrView method) {
+  if (method.equals("GET")) return ROUTE_GET;
+  if (method.equals("POST")) return ROUTE_POST;
+  return ROUTE_OTHER;
+}
+
+// slot -> route index, or NO_ROUTE
+struct RouteIndex {
+  uint16_t seed;
+  bool perfect;
+  uint8_t slot[ROUTE_SLOTS];
+};
+
+template <typename R, size_t N>
+constexpr RouteIndex buildRouteIndex(const R (&routes)[N]) {
+  static_assert(N < ROUTE_SLOTS, "more routes than ROUTE_SLOTS");
+  RouteIndex index = {};
+  for (uint16_t seed = 0; seed < MAX_ROUTE_SEEDS && !index.perfect; ++seed) {
+    index.seed = seed;
+    index.perfect = true;
+    for (uint8_t s = 0; s < ROUTE_SLOTS; ++s) index.slot[s] = NO_ROUTE;
+    for (size_t i = 0; i < N && index.perfect; ++i) {
+      uint8_t s = routeSlot(seed, routes[i].method, routes[i].path);
+      if (index.slot[s] != NO_ROUTE) index.perfect = false;
+      index.slot[s] = (uint8_t)i;
+    }
+  }
+  return index;
+}
+
+// the route matching the request, or nullptr
+template <typename R, size_t N>
+const R* findRoute(const R (&routes)[N], const RouteIndex& index, RouteMethod method, StrView path) {
+  if (method == ROUTE_OTHER) return nullptr;
+  uint8_t i = index.slot[routeSlot(index.seed, method, path)];
+  if (i == NO_ROUTE || routes[i].method != method || !path.equals(routes[i].path)) return nullptr;
+  return &routes[i];
+}
+
+enum ParamResult : uint8_t {
+  PARAMS_OK = 0,
+  PARAM_MISSING,
+  PARAM_OUT_OF_RANGE
+};
+
+// reads every parameter of the schema into values; on failure bad names it
+inline ParamResult readRouteParams(const RouteParam* params, const HttpRequestParser& request,
+                                   long* values, const char*& bad) {
+  for (uint8_t i = 0; i < MAX_ROUTE_PARAMS && params[i].name; ++i) {
+    const RouteParam& p = params[i];
+    long v;
+    bad = p.name;
+    if (!request.paramInt(p.name, v)) {
+      if (p.required) return PARAM_MISSING;
+      v = p.fallback;
+    } else if (v < p.min || v > p.max) {
+      if (!p.clamp) return PARAM_OUT_OF_RANGE;
+      v = v < p.min ? p.min : p.max;
+    }
+    values[i] = v;
+  }
+  return PARAMS_OK;
+}
+
+#endif
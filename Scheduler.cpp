@@ -0,0 +1,99 @@
+#include "Scheduler.h"
+
+bool Scheduler::addTask(const char* name, BasicManager& manager, uint32_t periodUs, uint32_t budgetUs) {
+  if (count >= MAX_TASKS) return false;
+
+  // one grid for every task, so tasks on commensurate periods fall due
+  // together however long init took between their addTask calls
+  if (count == 0) startUs = micros();
+
+  Task& t = tasks[count++];
+  t.name = name;
+  t.manager = &manager;
+  t.periodUs = periodUs;
+  t.budgetUs = budgetUs;
+  t.nextDueUs = startUs;
+  return true;
+}
+
+uint8_t Scheduler::run(unsigned long nowMs) {
+  uint8_t ran = 0;
+  uint32_t passStartUs = micros();
+
+  for (uint8_t i = 0; i < count; ++i) {
+    Task& t = tasks[i];
+
+    // wrap-safe "now >= due", with now the start of the pass: a slot that
+    // falls due while earlier tasks run waits for the next pass, for every
+    // task alike, so a pass never runs half of a slot's tasks
+    if ((int32_t)(passStartUs - t.nextDueUs) < 0) continue;
+    uint32_t startUs = micros();
+    int32_t late = (int32_t)(startUs - t.nextDueUs);
+
+    // every run and every skipped period moved nextDueUs one slot on
+    if (t.periodUs > 0) {
+      runningSlot = t.runs + t.missed;
+      runningLateUs = late;
+    }
+    t.manager->update(nowMs);
+    runningSlot = 0;
+    runningLateUs = 0;
+    uint32_t endUs = micros();
+
+    t.runs++;
+    t.lastRunUs = endUs - startUs;
+    if (t.lastRunUs > t.maxRunUs) t.maxRunUs = t.lastRunUs;
+    t.runTimes.record(t.lastRunUs);
+    if (t.budgetUs > 0 && t.lastRunUs > t.budgetUs) t.overruns++;
+
+    if (t.periodUs == 0) {
+      t.nextDueUs = endUs;
+    } else {
+      if ((uint32_t)late > t.maxJitterUs) t.maxJitterUs = late;
+
+      // keep the grid fixed; if the pass started a whole period late, skip
+      // the missed slots but stay on the grid, so tasks on commensurate
+      // periods (commands, motor, servo) keep running in the same passes
+      t.nextDueUs += t.periodUs;
+      if ((int32_t)(passStartUs - t.nextDueUs) >= 0) {
+        uint32_t behind = (passStartUs - t.nextDueUs) / t.periodUs + 1;
+        t.missed += behind;
+        t.nextDueUs += behind * t.periodUs;
+      }
+    }
+    ran++;
+  }
+
+  uint32_t passUs = micros() - passStartUs;
+  passTimes.record(passUs);
+  if (passBudgetUs > 0 && passUs > passBudgetUs) passOverruns++;
+  return ran;
+}
+
+uint8_t Scheduler::taskCount() const {
+  return count;
+}
+
+const Scheduler::Task& Scheduler::task(uint8_t i) const {
+  return tasks[i < count ? i : 0];
+}
+
+uint32_t Scheduler::currentSlot() const {
+  return runningSlot;
+}
+
+uint32_t Scheduler::currentLateUs() const {
+  return runningLateUs;
+}
+
+void Scheduler::setPassBudget(uint32_t budgetUs) {
+  passBudgetUs = budgetUs;
+}
+
+const LatencyHistogram& Scheduler::getPassTimes() const {
+  return passTimes;
+}
+
+uint32_t Scheduler::getPassOverruns() const {
+  return passOverruns;
+}
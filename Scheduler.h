@@ -0,0 +1,61 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <Arduino.h>
+#include "BasicManager.h"
+#include "LatencyHistogram.h"
+
+// Fixed-rate cooperative scheduler over BasicManagers
+class Scheduler {
+  public:
+    static const uint8_t MAX_TASKS = 12;
+
+    struct Task {
+      const char* name = nullptr;
+      BasicManager* manager = nullptr;
+      uint32_t periodUs = 0;   // 0 runs on every pass
+      uint32_t budgetUs = 0;   // a run longer than this is an overrun
+      uint32_t nextDueUs = 0;
+
+      uint32_t runs = 0;
+      uint32_t overruns = 0;   // runs that went over budget
+      uint32_t missed = 0;     // whole periods skipped because we fell behind
+      uint32_t lastRunUs = 0;
+      uint32_t maxRunUs = 0;
+      uint32_t maxJitterUs = 0; // worst start delay past the deadline
+      LatencyHistogram runTimes;
+    };
+
+    // tasks run in the order they are added when due in the same pass; every
+    // periodic task's grid starts where the first one was added
+    bool addTask(const char* name, BasicManager& manager, uint32_t periodUs, uint32_t budgetUs);
+
+    // runs every task that is due; returns how many ran
+    uint8_t run(unsigned long nowMs);
+
+    uint8_t taskCount() const;
+    const Task& task(uint8_t i) const;
+
+    // while a periodic task runs: the grid slot it runs for (0 is the
+    // scheduler's start) and how long after that slot it started; 0 otherwise
+    uint32_t currentSlot() const;
+    uint32_t currentLateUs() const;
+
+    // a whole pass longer than this counts as a loop overrun (0 disables)
+    void setPassBudget(uint32_t budgetUs);
+    const LatencyHistogram& getPassTimes() const;
+    uint32_t getPassOverruns() const;
+
+  private:
+    Task tasks[MAX_TASKS];
+    uint8_t count = 0;
+    uint32_t startUs = 0; // micros() at the first addTask
+    uint32_t runningSlot = 0;
+    uint32_t runningLateUs = 0;
+
+    uint32_t passBudgetUs = 0;
+    uint32_t passOverruns = 0;
+    LatencyHistogram passTimes;
+};
+
+#endif
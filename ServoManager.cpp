@@ -2,8 +2,12 @@
 
 void ServoManager::init() {
   servo.attach(PWM);
-  angle = STR;
-  servo.write(angle);
+  steering = 0;
+  targetUs = pulseFor(0);
+  pulse = (int32_t)targetUs << PULSE_FRAC_BITS;
+  lastStepUs = micros();
+  written = -1;
+  applyServoOutput();
 
   initialized = true;
 }
@@ -13,14 +17,107 @@ void ServoManager::update(unsigned long now) {
   applyServoOutput();
 }
 
-void ServoManager::setAngle(ServoManager::Angle new_angle) {
-  angle = new_angle;
+void ServoManager::setSteering(int value) {
+  int8_t s = constrain(value, -100, 100);
+  uint16_t us = pulseFor(s);
+
+  // jitter on the input must not keep the servo hunting
+  int diff = (int)us - (int)targetUs;
+  if (diff < 0) diff = -diff;
+  if (diff < cal.deadbandUs && s != 0) return;
+
+  steering = s;
+  targetUs = us;
+}
+
+int8_t ServoManager::getSteering() const {
+  return steering;
+}
+
+uint16_t ServoManager::getPulseUs() const {
+  return (uint16_t)((pulse + (1 << (PULSE_FRAC_BITS - 1))) >> PULSE_FRAC_BITS);
 }
 
-ServoManager::Angle ServoManager::getAngle() const {
-  return angle;
+void ServoManager::setCalibration(const Calibration& c) {
+  cal = c;
+  targetUs = pulseFor(steering);
+}
+
+const ServoManager::Calibration& ServoManager::getCalibration() const {
+  return cal;
+}
+
+int8_t ServoManager::steeringFromDegrees(int degrees) {
+  // 15 degrees either side of 105 was full lock
+  long s = ((long)degrees - 105) * 100 / 15;
+  return constrain(s, -100, 100);
+}
+
+void ServoManager::stampCommand(uint32_t us) {
+  // keep the oldest unapplied one, that's the delay the driver feels
+  if (commandPending) return;
+  commandStampUs = us;
+  commandPending = true;
+}
+
+const LatencyHistogram& ServoManager::getCommandLatency() const {
+  return commandLatency;
+}
+
+uint32_t ServoManager::getWritesIssued() const {
+  return writesIssued;
+}
+
+uint32_t ServoManager::getWritesElided() const {
+  return writesElided;
+}
+
+uint16_t ServoManager::pulseFor(int s) const {
+  // expo: blend of linear and cubic, in 1/10000 of full lock
+  int32_t x = s;
+  int32_t shaped = ((100 - cal.expo) * x * 100 + cal.expo * (x * x * x / 100)) / 100;
+
+  int32_t center = cal.centerUs + cal.trimUs;
+  int32_t span = shaped < 0 ? (int32_t)cal.centerUs - cal.leftUs : (int32_t)cal.rightUs - cal.centerUs;
+  int32_t us = center + shaped * span / 10000;
+
+  // never drive past the calibrated endpoints, trim included
+  int32_t lo = cal.leftUs < cal.rightUs ? cal.leftUs : cal.rightUs;
+  int32_t hi = cal.leftUs < cal.rightUs ? cal.rightUs : cal.leftUs;
+  return (uint16_t)constrain(us, lo, hi);
 }
 
 void ServoManager::applyServoOutput() {
-  servo.write(static_cast<int>(angle));
-}
\ No newline at end of file
+  uint32_t nowUs = micros();
+  uint32_t dtUs = nowUs - lastStepUs;
+  if (dtUs > MAX_STEP_US) dtUs = MAX_STEP_US;
+  lastStepUs = nowUs;
+
+  // slew toward the target
+  int32_t goal = (int32_t)targetUs << PULSE_FRAC_BITS;
+  int32_t remaining = goal - pulse;
+  if (cal.slewUsPerSec == 0 || written < 0) {
+    pulse = goal;
+  } else if (remaining != 0) {
+    int32_t step = (int32_t)(((uint64_t)cal.slewUsPerSec << PULSE_FRAC_BITS) * dtUs / 1000000UL);
+    if (step < 1) step = 1;
+    if (remaining > step) pulse += step;
+    else if (remaining < -step) pulse -= step;
+    else pulse = goal;
+  }
+
+  // rewriting the same pulse would only restart the pulse timer
+  int us = getPulseUs();
+  if (written == us) {
+    writesElided++;
+  } else {
+    servo.writeMicroseconds(us);
+    written = us;
+    writesIssued++;
+  }
+
+  if (commandPending) {
+    commandLatency.record(nowUs - commandStampUs);
+    commandPending = false;
+  }
+}
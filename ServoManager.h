@@ -2,26 +2,67 @@
 #define SERVO_MANAGER_H
 
 #include "BasicManager.h"
+#include "LatencyHistogram.h"
 #include <Servo.h>
 
+// Proportional steering: -100 (full left) .. 100 (full right), shaped by
+// an expo curve, mapped onto calibrated pulse widths and slewed in µs.
 class ServoManager : public BasicManager {
   public:
-    enum Angle {STR = 105, LEFT = 90, RIGHT = 120};
+    struct Calibration {
+      uint16_t leftUs = 1472;   // the old 90/105/120 degree positions
+      uint16_t centerUs = 1627;
+      uint16_t rightUs = 1781;
+      int16_t trimUs = 0;       // added to every pulse
+      uint8_t expo = 30;        // 0 linear .. 100 fully cubic around center
+      uint16_t slewUsPerSec = 2000; // 0 = no limit
+      uint8_t deadbandUs = 3;   // smaller target changes are ignored
+    };
 
     void init() override;
     void update(unsigned long now) override;
 
-    void setAngle(Angle angle);
+    void setSteering(int steering);
+    int8_t getSteering() const;
+    uint16_t getPulseUs() const; // pulse currently being output
 
-    Angle getAngle() const;
+    void setCalibration(const Calibration& cal);
+    const Calibration& getCalibration() const;
+
+    // old /setServoAngle degrees (90 left .. 105 center .. 120 right)
+    static int8_t steeringFromDegrees(int degrees);
+
+    // time a command arrived; the next output write records the delay
+    void stampCommand(uint32_t us);
+    const LatencyHistogram& getCommandLatency() const;
+
+    uint32_t getWritesIssued() const;
+    uint32_t getWritesElided() const;
 
   private:
+    static const uint8_t PULSE_FRAC_BITS = 4;
+    static const uint32_t MAX_STEP_US = 100000;
+
     const uint8_t PWM = 6;
 
-    Angle angle = STR;
+    Calibration cal;
+    int8_t steering = 0;
+    uint16_t targetUs = 0;
+    int32_t pulse = 0;        // slewed pulse, µs << PULSE_FRAC_BITS
+    uint32_t lastStepUs = 0;
+
     Servo servo;
+    int written = -1; // last pulse handed to the servo, -1 before the first
+
+    uint32_t writesIssued = 0;
+    uint32_t writesElided = 0;
+
+    uint32_t commandStampUs = 0;
+    bool commandPending = false;
+    LatencyHistogram commandLatency;
 
+    uint16_t pulseFor(int steering) const;
     void applyServoOutput();
 };
 
-#endif
\ No newline at end of file
+#endif
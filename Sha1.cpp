@@ -0,0 +1,92 @@
+#include "Sha1.h"
+
+static inline uint32_t rol(uint32_t v, uint8_t bits) {
+  return (v << bits) | (v >> (32 - bits));
+}
+
+Sha1::Sha1() {
+  reset();
+}
+
+void Sha1::reset() {
+  state[0] = 0x67452301;
+  state[1] = 0xEFCDAB89;
+  state[2] = 0x98BADCFE;
+  state[3] = 0x10325476;
+  state[4] = 0xC3D2E1F0;
+  blockLen = 0;
+  totalLen = 0;
+}
+
+void Sha1::update(const uint8_t* data, size_t len) {
+  totalLen += len;
+  while (len--) {
+    block[blockLen++] = *data++;
+    if (blockLen == sizeof(block)) {
+      processBlock();
+      blockLen = 0;
+    }
+  }
+}
+
+void Sha1::finish(uint8_t digest[DIGEST_SIZE]) {
+  uint32_t bits = totalLen * 8;
+
+  // pad with 0x80, zeros and the 64-bit big-endian message length
+  block[blockLen++] = 0x80;
+  if (blockLen > 56) {
+    while (blockLen < 64) block[blockLen++] = 0;
+    processBlock();
+    blockLen = 0;
+  }
+  while (blockLen < 60) block[blockLen++] = 0;
+  block[60] = bits >> 24;
+  block[61] = bits >> 16;
+  block[62] = bits >> 8;
+  block[63] = bits;
+  processBlock();
+
+  for (uint8_t i = 0; i < 5; ++i) {
+    digest[i * 4]     = state[i] >> 24;
+    digest[i * 4 + 1] = state[i] >> 16;
+    digest[i * 4 + 2] = state[i] >> 8;
+    digest[i * 4 + 3] = state[i];
+  }
+  reset();
+}
+
+void Sha1::processBlock() {
+  uint32_t w[16];
+  for (uint8_t i = 0; i < 16; ++i) {
+    w[i] = ((uint32_t)block[i * 4] << 24) | ((uint32_t)block[i * 4 + 1] << 16) |
+           ((uint32_t)block[i * 4 + 2] << 8) | block[i * 4 + 3];
+  }
+
+  uint32_t a = state[0], b = state[1], c = state[2], d = state[3], e = state[4];
+
+  for (uint8_t i = 0; i < 80; ++i) {
+    if (i >= 16) {
+      // 16-word rolling message schedule
+      w[i & 15] = rol(w[(i + 13) & 15] ^ w[(i + 8) & 15] ^ w[(i + 2) & 15] ^ w[i & 15], 1);
+    }
+
+    uint32_t f, k;
+    if (i < 20)      { f = (b & c) | (~b & d);           k = 0x5A827999; }
+    else if (i < 40) { f = b ^ c ^ d;                    k = 0x6ED9EBA1; }
+    else if (i < 60) { f = (b & c) | (b & d) | (c & d);  k = 0x8F1BBCDC; }
+    else             { f = b ^ c ^ d;                    k = 0xCA62C1D6; }
+
+    uint32_t t = rol(a, 5) + f + e + k + w[i & 15];
+    e = d;
+    d = c;
+    c = rol(b, 30);
+    b = a;
+    a = t;
+  }
+
+  state[0] += a;
+  state[1] += b;
+  state[2] += c;
+  state[3] += d;
+  state[4] += e;
+}
@@ -0,0 +1,26 @@
+#ifndef SHA1_H
+#define SHA1_H
+
+#include <Arduino.h>
+
+// Minimal SHA-1, only used for the WebSocket handshake
+class Sha1 {
+  public:
+    static const size_t DIGEST_SIZE = 20;
+
+    Sha1();
+
+    void reset();
+    void update(const uint8_t* data, size_t len);
+    void finish(uint8_t digest[DIGEST_SIZE]);
+
+  private:
+    uint32_t state[5];
+    uint8_t block[64];
+    uint8_t blockLen = 0;
+    uint32_t totalLen = 0;
+
+    void processBlock();
+};
+
+#endif
@@ -0,0 +1,54 @@
+#include "SpeedController.h"
+
+void SpeedController::setGains(const Gains& g) {
+  gains = g;
+}
+
+const SpeedController::Gains& SpeedController::getGains() const {
+  return gains;
+}
+
+void SpeedController::reset() {
+  integral = 0;
+  primed = false;
+  out = 0;
+}
+
+int16_t SpeedController::output() const {
+  return out;
+}
+
+int16_t SpeedController::step(int16_t setpoint, int16_t measured, uint32_t dtUs) {
+  if (setpoint == 0) {
+    reset();
+    return 0;
+  }
+
+  // all terms in PWM, Q8: a Q10 gain times mm/s, shifted down by 2
+  int32_t err = (int32_t)setpoint - measured;
+  int32_t ff = (int32_t)gains.kff * setpoint >> 2;
+  int32_t p = (int32_t)gains.kp * err >> 2;
+
+  int32_t d = 0;
+  if (primed && dtUs > 0) {
+    // on the measurement, so setpoint steps don't kick
+    int32_t rate = ((int32_t)measured - lastMeasured) * 1000 / (int32_t)dtUs;
+    d = -(int32_t)gains.kd * rate >> 2;
+  }
+  lastMeasured = measured;
+  primed = true;
+
+  int32_t candidate = integral + (int32_t)(((int64_t)gains.ki * err >> 2) * dtUs / 1000000);
+  candidate = constrain(candidate, -OUT_LIMIT, OUT_LIMIT);
+
+  // anti-windup: hold the integrator while it would only deepen saturation
+  int32_t u = ff + p + candidate + d;
+  if (!((u > OUT_LIMIT && err > 0) || (u < -OUT_LIMIT && err < 0))) integral = candidate;
+  u = ff + p + integral + d;
+
+  int32_t pwm = (u + (u < 0 ? -128 : 128)) / 256;
+  if (setpoint > 0) pwm = constrain(pwm, 0, 255);
+  else pwm = constrain(pwm, -255, 0);
+  out = (int16_t)pwm;
+  return out;
+}
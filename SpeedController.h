@@ -0,0 +1,39 @@
+#ifndef SPEED_CONTROLLER_H
+#define SPEED_CONTROLLER_H
+
+#include <Arduino.h>
+
+// Fixed-point feed-forward + PID for one wheel: speed in mm/s, PWM out.
+// The integrator only moves while the output is not pushed further into
+// saturation, and the output never drives against the setpoint (slowing
+// down is left to coasting, as in open loop).
+class SpeedController {
+  public:
+    // PWM per mm/s in Q10 (1024 = 1.0); ki per mm/s per second of error,
+    // kd per mm/s of change per millisecond
+    struct Gains {
+      int16_t kff = 261; // ~255 PWM at 1000 mm/s
+      int16_t kp = 200;
+      int16_t ki = 600;
+      int16_t kd = 0;    // encoder speed is too coarse for much D
+    };
+
+    void setGains(const Gains& g);
+    const Gains& getGains() const;
+
+    // one control step; dtUs is the time since the previous one
+    int16_t step(int16_t setpoint, int16_t measured, uint32_t dtUs);
+    void reset();
+    int16_t output() const;
+
+  private:
+    static const int32_t OUT_LIMIT = 255L << 8;
+
+    Gains gains;
+    int32_t integral = 0; // PWM, Q8
+    int16_t lastMeasured = 0;
+    bool primed = false;
+    int16_t out = 0;
+};
+
+#endif
@@ -1,4 +1,22 @@
 #include "StateManager.h"
+#include <stdarg.h>
+
+// snprintf onto the end of out, stopping cleanly when it is full
+static void appendf(char* out, size_t size, size_t& len, const char* fmt, ...) {
+  if (len + 1 >= size) return;
+  va_list args;
+  va_start(args, fmt);
+  int n = vsnprintf(out + len, size - len, fmt, args);
+  va_end(args);
+  if (n > 0) len += ((size_t)n < size - len) ? n : size - len - 1;
+}
+
+// a join that outlasts the hardware watchdog resets the board mid-reconnect
+static_assert(WiFiManager::JOIN_WAIT_MS < FailsafeManager::HW_WATCHDOG_MS / 4,
+              "WiFi.begin() may block for as long as the hardware watchdog allows");
+
+// the queue tells stops apart by MotorManager's value for them
+static_assert(CommandQueue::STOP_DIRECTION == MotorManager::STOP, "CommandQueue::STOP_DIRECTION is stale");
 
 StateManager& StateManager::instance() {
   static StateManager inst;
@@ -8,88 +26,296 @@ StateManager& StateManager::instance() {
 StateManager::StateManager() {}
 
 void StateManager::init(const char* ssid, const char* pass) {
+  LogManager& log = LogManager::instance();
+  log.init();
+
   // 1. init display
   display.init();
   setBootStep(BOOT_START);
-  Serial.println("<State Manager log> BOOT START");
+  LOG_INFO("<State Manager log> BOOT START");
 
-  // 2. connect to wifi
+  // 2. start wifi; the link comes up (and back) in the background
   setBootStep(BOOT_WIFI_CONNECTING);
+  wifi.attachLinkCallback([](bool up) {
+    StateManager::instance().onLinkChange(up);
+  });
   wifi.init(ssid, pass);
-  if (wifi.connect()) {
-    setBootStep(BOOT_WIFI_CONNECTED);
-    display.setIPAddress(wifi.getIPAddress());
-    setBootStep(BOOT_WIFI_GOT_IP);
-    Serial.println("<State Manager log> WiFi connected");
-  } else {
-    Serial.println("<State Manager log> WiFi not connected");
-  }
-  
+
   // 3. motor/servo init
   motor.init();
   servo.init();
-  Serial.println("<State Manager log> motors init");
+  LOG_INFO("<State Manager log> motors init");
   // 4. webserver init
   setBootStep(BOOT_WEBSERVER_START);
-  Serial.println("<State Manager log> Launching webserver...");
+  LOG_INFO("<State Manager log> Launching webserver...");
   server.attachMotorOutputCallback([](uint8_t value) {
-    StateManager::instance().cmd_setMotorSpeed(value);
+    return StateManager::instance().cmd_setMotorSpeed(value);
   });
   
   server.attachMotorDirCallback([](int dir) {
-    StateManager::instance().cmd_setMotorDir(dir);
+    return StateManager::instance().cmd_setMotorDir(dir);
   });
 
   server.attachServoAngleCallback([](int angle) {
-    StateManager::instance().cmd_setSteering(angle);
+    return StateManager::instance().cmd_setSteering(angle);
   });
 
+  server.attachDriveModeCallback([](int mode) {
+    return StateManager::instance().cmd_setDriveMode(mode);
+  });
+
+  server.attachTankCallback([](int left, int right) {
+    return StateManager::instance().cmd_setTank(left, right);
+  });
+
+  server.attachControlFrameCallback([](const ControlFrame& frame, uint8_t channel) {
+    return StateManager::instance().cmd_applyControl(frame, FlightRecorder::SOURCE_WEB, channel);
+  });
+
+  server.attachHeartbeatCallback([]() {
+    StateManager::instance().cmd_heartbeat();
+  });
+
+  server.attachArmCallback([]() {
+    return StateManager::instance().cmd_arm();
+  });
+
+  server.attachMetricsCallback([](char* out, size_t size) {
+    return StateManager::instance().formatMetrics(out, size);
+  });
+
+  server.attachEventCallback([](char* out, size_t size) {
+    return StateManager::instance().formatEvent(out, size);
+  });
+  server.attachRecorderCallback([](Print* out) {
+    return StateManager::instance().dumpRecorder(out);
+  });
+
+  server.setEventInterval(200); // 5 Hz unless a page asks for another rate
+
   server.init(); // register routes but not start blocking
+
+  // 5. udp control listener next to the http server
+  udp.attachControlFrameCallback([](const ControlFrame& frame) {
+    return StateManager::instance().cmd_applyControl(frame, FlightRecorder::SOURCE_UDP, CONTROL_UDP);
+  });
+  udp.attachTelemetryCallback([](TelemetryFrame& t) {
+    StateManager::instance().fillTelemetry(t);
+  });
+  udp.init();
   setBootStep(BOOT_READY);
-  Serial.println("<State Manager log> Ready to go!");
+  LOG_INFO("<State Manager log> Ready to go!");
   // display show ready state and init info
   display.setStat(DisplayManager::WEBSERVER_READY);
-  display.setInfo(motor.getMaxOutput(), motor.getDirection(), servo.getAngle());
+  display.setInfo(motor.getMaxOutput(), motor.getDirection(), steeringCommand);
 
+  // 6. command watchdog
+  failsafe.attachTripCallback([]() {
+    StateManager::instance().onFailsafeTrip();
+  });
+  failsafe.init();
+
+  // 7. task table: period and budget in microseconds, in priority order
+  status.init();
+  recorderTask.init();
+  commandTask.init();
+  scheduler.addTask("failsafe", failsafe, 20000, 200); // first, and cheap
+  scheduler.addTask("http", server, 0, 5000);          // network I/O every pass
+  scheduler.addTask("udp", udp, 0, 1000);
+  scheduler.addTask("commands", commandTask, 5000, 200); // same grid as motor, runs first
+  scheduler.addTask("motor", motor, 5000, 500);        // 200 Hz
+  scheduler.addTask("servo", servo, 20000, 500);       // 50 Hz, one servo frame
+  scheduler.addTask("recorder", recorderTask, 0, 100); // right after the actuators
+  scheduler.addTask("status", status, 200000, 500);
+  scheduler.addTask("display", display, 200000, 50000); // 5 Hz, I2C bound
+  scheduler.addTask("wifi", wifi, 1000000, 2000);      // 1 Hz link health
+  scheduler.addTask("log", log, 0, 500);               // drains into free UART room
+  scheduler.setPassBudget(5000); // a longer pass delays the motor task
+
+  // boot messages out before setup() prints its banner
+  log.flush();
   lastUpdateMs = millis();
 }
 
 void StateManager::update(unsigned long now) {
-  wifi.update(now);
-  server.update(now);
-  motor.update(now);
-  servo.update(now);
-  display.update(now);
+  scheduler.run(now);
+  lastUpdateMs = now;
+}
 
-  display.setInfo(motor.getMaxOutput(), motor.getDirection(), servo.getAngle());
-  
-  static bool prevWifiConnected = false;
-  bool connected = wifi.isConnected();
-  
-  if (connected && !prevWifiConnected) {
-    // newly connected
+void StateManager::StatusTask::update(unsigned long now) {
+  if (!initialized) return;
+  StateManager::instance().refreshStatus(now);
+  StateManager::instance().pollConsole();
+}
+
+void StateManager::CommandTask::update(unsigned long now) {
+  if (!initialized) return;
+  StateManager::instance().applyCommands();
+}
+
+void StateManager::RecorderTask::update(unsigned long now) {
+  if (!initialized) return;
+  StateManager& s = StateManager::instance();
+  s.recorder.recordOutput(s.motor.getAppliedOutput(MotorManager::CHANNEL_LEFT),
+                          s.motor.getAppliedOutput(MotorManager::CHANNEL_RIGHT),
+                          s.servo.getPulseUs(), s.failsafe.getState(), s.motor.isRamping(),
+                          s.motor.getOutputTarget(MotorManager::CHANNEL_LEFT),
+                          s.motor.getOutputTarget(MotorManager::CHANNEL_RIGHT));
+}
+
+void StateManager::refreshStatus(unsigned long now) {
+  display.setFailsafe(failsafe.isTripped());
+  display.setInfo(motor.getMaxOutput(), motor.getDirection(), steeringCommand);
+
+  display.setStat(wifi.isConnected() ? DisplayManager::WEBSERVER_READY : DisplayManager::WIFI_CONNECTING);
+}
+
+void StateManager::onLinkChange(bool up) {
+  recorder.record(FlightRecorder::EVENT_LINK, FlightRecorder::SOURCE_SELF, 0, up ? 1 : 0);
+  if (up) {
     display.setIPAddress(wifi.getIPAddress());
-    display.setStat(DisplayManager::WIFI_GOT_IP);
-  } else if (!connected && prevWifiConnected) {
-    // lost connection
-    display.setStat(DisplayManager::WIFI_CONNECTING);
+    IPAddress ip = wifi.getLocalIP();
+    LOG_INFO("<State Manager log> WiFi connected, IP: %ld.%ld.%ld.%ld", ip[0], ip[1], ip[2], ip[3]);
   } else {
-    display.setStat(DisplayManager::WEBSERVER_READY);
+    // no operator can reach us; don't keep driving on the last command,
+    // nor on one still queued for the next cycle
+    voidQueuedCommands();
+    motor.setDirection(MotorManager::STOP);
+    LOG_INFO("<State Manager log> WiFi lost, motors stopped");
   }
-  prevWifiConnected = connected;
-
-  lastUpdateMs = now;
 }
 
 BootStep StateManager::getBootStep() const { return bootStep; }
+const Scheduler& StateManager::getScheduler() const { return scheduler; }
+const FlightRecorder& StateManager::getRecorder() const { return recorder; }
 String StateManager::getIPAddress() const { return wifi.getIPAddress(); }
 
-// command from webserver
-void StateManager::cmd_setMotorSpeed(uint8_t rate) {
-  motor.setMaxOutput(rate);
+void StateManager::pollConsole() {
+  while (Serial.available() > 0) {
+    char c = Serial.read();
+    if (c != '\n' && c != '\r') {
+      if (consoleLen < CONSOLE_LINE) consoleLine[consoleLen++] = c;
+      continue;
+    }
+    consoleLine[consoleLen] = '\0';
+    consoleLen = 0;
+
+    if (strcmp(consoleLine, "metrics") == 0) {
+      LogManager::instance().flush();
+      server.printMetrics(Serial);
+    } else if (strcmp(consoleLine, "recorder") == 0) {
+      // a text line with the length, then the raw dump
+      LogManager::instance().flush();
+      Serial.print("recorder ");
+      Serial.println((unsigned long)dumpRecorder(nullptr));
+      dumpRecorder(&Serial);
+      Serial.println();
+    }
+  }
 }
 
-void StateManager::cmd_setMotorDir(int dir) {
+size_t StateManager::formatMetrics(char* out, size_t size) const {
+  size_t len = 0;
+  char hist[80];
+
+  appendf(out, size, len, "# times in us\nuptime_ms %lu\n", millis());
+
+  const LatencyHistogram& pass = scheduler.getPassTimes();
+  pass.format(hist, sizeof(hist));
+  appendf(out, size, len, "pass %s mean=%lu over=%lu\n",
+          hist, (unsigned long)pass.mean(), (unsigned long)scheduler.getPassOverruns());
+
+  for (uint8_t i = 0; i < scheduler.taskCount(); ++i) {
+    const Scheduler::Task& t = scheduler.task(i);
+    t.runTimes.format(hist, sizeof(hist));
+    appendf(out, size, len, "task.%s %s over=%lu missed=%lu jitter=%lu\n",
+            t.name, hist, (unsigned long)t.overruns, (unsigned long)t.missed, (unsigned long)t.maxJitterUs);
+  }
+
+  // command arrival to output write
+  motor.getCommandLatency().format(hist, sizeof(hist));
+  appendf(out, size, len, "cmd.motor %s\n", hist);
+  servo.getCommandLatency().format(hist, sizeof(hist));
+  appendf(out, size, len, "cmd.servo %s\n", hist);
+
+  appendf(out, size, len, "motor mode=%s left=%d right=%d writes=%lu elided=%lu\n",
+          DriveMixer::name(motor.getDriveMode()),
+          motor.getAppliedOutput(MotorManager::CHANNEL_LEFT), motor.getAppliedOutput(MotorManager::CHANNEL_RIGHT),
+          (unsigned long)motor.getWritesIssued(), (unsigned long)motor.getWritesElided());
+  if (motor.hasEncoders()) {
+    appendf(out, size, len, "speed.left set=%d meas=%d fault=%d\nspeed.right set=%d meas=%d fault=%d\n",
+            motor.getSpeedSetpoint(MotorManager::CHANNEL_LEFT), motor.getMeasuredSpeed(MotorManager::CHANNEL_LEFT),
+            motor.hasEncoderFault(MotorManager::CHANNEL_LEFT) ? 1 : 0,
+            motor.getSpeedSetpoint(MotorManager::CHANNEL_RIGHT), motor.getMeasuredSpeed(MotorManager::CHANNEL_RIGHT),
+            motor.hasEncoderFault(MotorManager::CHANNEL_RIGHT) ? 1 : 0);
+  }
+  appendf(out, size, len, "servo pulse=%u writes=%lu elided=%lu\n", servo.getPulseUs(),
+          (unsigned long)servo.getWritesIssued(), (unsigned long)servo.getWritesElided());
+  appendf(out, size, len, "display pushed=%lu skipped=%lu pages=%lu\n",
+          (unsigned long)display.getFramesPushed(), (unsigned long)display.getFramesSkipped(),
+          (unsigned long)display.getPagesPushed());
+  appendf(out, size, len, "udp rx=%lu rejected=%lu stale=%lu\n",
+          (unsigned long)udp.getReceived(), (unsigned long)udp.getRejected(),
+          (unsigned long)staleControlFrames);
+  appendf(out, size, len, "ws coalesced=%lu\n", (unsigned long)server.getFramesCoalesced());
+  appendf(out, size, len, "queue depth=%u peak=%u posted=%lu coalesced=%lu discarded=%lu overflows=%lu\n",
+          commands.depth(), commands.getPeakDepth(), (unsigned long)commands.getPosted(),
+          (unsigned long)commands.getCoalesced(), (unsigned long)commands.getDiscarded(),
+          (unsigned long)commands.getOverflows());
+  appendf(out, size, len, "failsafe state=%u trips=%u timeout_ms=%lu\n",
+          failsafe.getState(), failsafe.getTrips(), (unsigned long)failsafe.getTimeout());
+  appendf(out, size, len, "wifi up=%d attempts=%u\n", wifi.isConnected() ? 1 : 0, wifi.getAttempts());
+  appendf(out, size, len, "log queued=%u dropped=%lu\n",
+          LogManager::instance().getQueued(), (unsigned long)LogManager::instance().getDropped());
+  return len;
+}
+
+size_t StateManager::formatEvent(char* out, size_t size) const {
+  size_t len = 0;
+  const LatencyHistogram& pass = scheduler.getPassTimes();
+  const LatencyHistogram& cmd = motor.getCommandLatency();
+
+  // age lets the page take the time we held the ack out of its round trip
+  appendf(out, size, len, "data: {\"t\":%lu,\"seq\":%u,\"age\":%lu,", millis(),
+          lastControlSeq, haveControlSeq ? millis() - lastControlMs : 0UL);
+  appendf(out, size, len, "\"thr\":%u,\"dir\":%u,\"mode\":%u,\"l\":%d,\"r\":%d,\"steer\":%d,\"pulse\":%u,",
+          motor.getMaxOutput(), motor.getDirection(), motor.getDriveMode(),
+          motor.getAppliedOutput(MotorManager::CHANNEL_LEFT), motor.getAppliedOutput(MotorManager::CHANNEL_RIGHT),
+          steeringCommand, servo.getPulseUs());
+  appendf(out, size, len, "\"sl\":%d,\"sr\":%d,\"vl\":%d,\"vr\":%d,",
+          motor.getSpeedSetpoint(MotorManager::CHANNEL_LEFT), motor.getSpeedSetpoint(MotorManager::CHANNEL_RIGHT),
+          motor.getMeasuredSpeed(MotorManager::CHANNEL_LEFT), motor.getMeasuredSpeed(MotorManager::CHANNEL_RIGHT));
+  appendf(out, size, len, "\"pass_p50\":%lu,\"pass_p99\":%lu,\"pass_max\":%lu,\"cmd_p50\":%lu,\"cmd_p99\":%lu,",
+          (unsigned long)pass.percentile(50), (unsigned long)pass.percentile(99), (unsigned long)pass.maximum(),
+          (unsigned long)cmd.percentile(50), (unsigned long)cmd.percentile(99));
+  appendf(out, size, len, "\"qd\":%u,\"qpeak\":%u,\"qco\":%lu,",
+          commands.depth(), commands.getPeakDepth(), (unsigned long)commands.getCoalesced());
+  appendf(out, size, len, "\"wifi\":%d,\"rssi\":%ld,\"fs\":%u,\"trips\":%u}\n\n",
+          wifi.isConnected() ? 1 : 0, (long)wifi.getRSSI(), failsafe.getState(), failsafe.getTrips());
+  return len;
+}
+
+size_t StateManager::dumpRecorder(Print* out) const {
+  return out ? recorder.dump(*out) : recorder.dumpSize();
+}
+
+// command from webserver; accepted here, applied by the command task.
+// false when refused: failsafe tripped or the queue full
+bool StateManager::cmd_setMotorSpeed(uint8_t rate) {
+  recorder.record(FlightRecorder::CMD_SPEED, FlightRecorder::SOURCE_WEB, 0, rate);
+  if (!acceptCommand()) return false;
+  motor.stampCommand(micros());
+  return commands.post(CommandQueue::SPEED, rate);
+}
+
+bool StateManager::cmd_setMotorDir(int dir) {
+  recorder.record(FlightRecorder::CMD_DIR, FlightRecorder::SOURCE_WEB, 0, dir);
+  if (!acceptCommand()) return false;
+  motor.stampCommand(micros());
+  return commands.post(CommandQueue::DIRECTION, dir);
+}
+
+void StateManager::applyDirection(int dir) {
   if (dir == 0) {
     motor.setDirection(MotorManager::FORWARD);
   } else if (dir == 1) {
@@ -99,16 +325,189 @@ void StateManager::cmd_setMotorDir(int dir) {
   }
 }
 
-void StateManager::cmd_setSteering(int angle) {
-  if (angle <= ServoManager::LEFT) {
-    servo.setAngle(ServoManager::LEFT);
-  } else if (ServoManager::RIGHT <= angle) {
-    servo.setAngle(ServoManager::RIGHT);
-  } else {
-    servo.setAngle(ServoManager::STR);
+bool StateManager::cmd_setSteering(int angle) {
+  recorder.record(FlightRecorder::CMD_STEER, FlightRecorder::SOURCE_WEB, 0, angle);
+  if (!acceptCommand()) return false;
+  servo.stampCommand(micros());
+  return commands.post(CommandQueue::STEERING, ServoManager::steeringFromDegrees(angle));
+}
+
+bool StateManager::cmd_setDriveMode(int mode) {
+  recorder.record(FlightRecorder::CMD_MODE, FlightRecorder::SOURCE_WEB, 0, mode);
+  if (mode < 0 || mode >= DriveMixer::MODE_COUNT) return false;
+  if (!commands.post(CommandQueue::MODE, mode)) return false;
+  driveModeCommand = (DriveMixer::Mode)mode;
+  return true;
+}
+
+bool StateManager::cmd_setTank(int left, int right) {
+  recorder.record(FlightRecorder::CMD_TANK, FlightRecorder::SOURCE_WEB, 0, left, right);
+  // per-side targets only mean something in tank mode; anywhere else the
+  // mixer would read them as throttle
+  if (driveModeCommand != DriveMixer::TANK) return false;
+  if (!acceptCommand()) return false;
+  motor.stampCommand(micros());
+  return commands.post(CommandQueue::TANK, left, right);
+}
+
+void StateManager::applyCommands() {
+  CommandQueue::Command pending[CommandQueue::SIZE];
+  uint8_t queued = commands.depth();
+  uint8_t n = commands.drain(pending);
+  // which control cycle took them, so a replay can apply them on the same one
+  if (queued > 0) {
+    uint32_t slot = scheduler.currentSlot();
+    uint32_t late = scheduler.currentLateUs();
+    recorder.record(FlightRecorder::EVENT_DRAIN, FlightRecorder::SOURCE_SELF, 0,
+                    (int16_t)(late < 0x7FFF ? late : 0x7FFF), (int16_t)(slot & 0xFFFF), (int16_t)(slot >> 16), n);
+  }
+  for (uint8_t i = 0; i < n; ++i) {
+    const CommandQueue::Command& cmd = pending[i];
+    switch (cmd.channel) {
+      case CommandQueue::SPEED:
+        motor.setMaxOutput(cmd.a);
+        break;
+      case CommandQueue::DIRECTION:
+        applyDirection(cmd.a);
+        break;
+      case CommandQueue::STEERING:
+        applySteering(cmd.a);
+        break;
+      case CommandQueue::MODE:
+        motor.setDriveMode((DriveMixer::Mode)cmd.a);
+        // re-route the current steering for the new mode
+        applySteering(steeringCommand);
+        LOG_INFO("<State Manager log> drive mode %ld", (long)cmd.a);
+        break;
+      case CommandQueue::TANK:
+        motor.setTank(cmd.a, cmd.b);
+        break;
+      case CommandQueue::DRIVE:
+        motor.setMaxOutput(cmd.a);
+        applyDirection(cmd.b);
+        applySteering(cmd.c);
+        break;
+    }
   }
 }
 
+void StateManager::cmd_heartbeat() {
+  recorder.record(FlightRecorder::CMD_HEARTBEAT, FlightRecorder::SOURCE_WEB);
+  acceptCommand();
+}
+
+bool StateManager::cmd_arm() {
+  recorder.record(FlightRecorder::CMD_ARM, FlightRecorder::SOURCE_WEB);
+  return rearm();
+}
+
+bool StateManager::rearm() {
+  if (!failsafe.isTripped()) return true;
+  // the trip left the motors stopped; only arm from there
+  if (motor.getDirection() != MotorManager::STOP || motor.isTankActive()) return false;
+  failsafe.arm(millis());
+  LOG_INFO("<State Manager log> failsafe re-armed");
+  return true;
+}
+
+void StateManager::noteControlSeq(ControlSeq& last, uint16_t seq) {
+  last.have = true;
+  last.seq = seq;
+  haveControlSeq = true;
+  lastControlSeq = seq;
+  lastControlMs = millis();
+}
+
+// a queued mode switch goes with the rest, so the mode as commanded falls
+// back to the one actually applied
+void StateManager::voidQueuedCommands() {
+  commands.invalidate();
+  driveModeCommand = motor.getDriveMode();
+}
+
+bool StateManager::acceptCommand() {
+  return failsafe.feed(millis());
+}
+
+void StateManager::onFailsafeTrip() {
+  // ramp down rather than slam the bridge, and straighten the wheels
+  recorder.record(FlightRecorder::EVENT_TRIP, FlightRecorder::SOURCE_SELF);
+  voidQueuedCommands();
+  motor.setDirection(MotorManager::STOP);
+  applySteering(0);
+  LOG_WARN("<State Manager log> failsafe: no command for %ld ms, stopping", failsafe.getTimeout());
+}
+
+// steering goes to the servo, the mixer, or both, depending on drive mode
+void StateManager::applySteering(int8_t steering) {
+  DriveMixer::Mode mode = motor.getDriveMode();
+  motor.setSteering(steering);
+  servo.setSteering(DriveMixer::usesServo(mode) ? steering : 0);
+  steeringCommand = steering;
+}
+
+// whole driver intent in one step, so motor and servo never disagree
+bool StateManager::cmd_applyControl(const ControlFrame& frame, FlightRecorder::Source source, uint8_t channel) {
+  if (channel >= CONTROL_CHANNELS) return false;
+  recorder.record(FlightRecorder::CMD_CONTROL, source, frame.seq,
+                  frame.throttle, frame.direction, frame.steering, frame.flags | channel << 8);
+  // every page, socket and UDP peer counts its own frames, so staleness is
+  // only judged against the same channel's last one
+  ControlSeq& last = controlSeq[channel];
+  // serial number arithmetic: anything not newer than the last one is stale
+  bool newer = !last.have || frame.has(ControlFrame::FLAG_RESYNC) || (int16_t)(frame.seq - last.seq) > 0;
+
+  // stopping is always allowed, tripped or not, stale or not, and skips the queue
+  if (frame.has(ControlFrame::FLAG_ESTOP)) {
+    voidQueuedCommands();
+    motor.emergencyStop();
+    applySteering(0);
+    acceptCommand();
+    if (newer) noteControlSeq(last, frame.seq);
+    return true;
+  }
+
+  if (!newer) {
+    staleControlFrames++;
+    return false;
+  }
+  noteControlSeq(last, frame.seq);
+
+  if (frame.has(ControlFrame::FLAG_ARM) && failsafe.isTripped()) {
+    bool stopped = frame.direction == MotorManager::STOP || frame.throttle == 0;
+    if (!stopped || !rearm()) return false;
+  }
+  if (!acceptCommand()) return false;
+
+  uint32_t stamp = micros();
+  motor.stampCommand(stamp);
+  servo.stampCommand(stamp);
+
+  return commands.post(CommandQueue::DRIVE, frame.throttle, frame.direction, frame.steering);
+}
+
+void StateManager::fillTelemetry(TelemetryFrame& t) const {
+  t.flags = wifi.isConnected() ? TelemetryFrame::FLAG_WIFI_UP : 0;
+  if (failsafe.isTripped()) t.flags |= TelemetryFrame::FLAG_FAILSAFE;
+  t.failsafeTrips = failsafe.getTrips();
+  t.ackSeq = lastControlSeq;
+  t.throttle = motor.getMaxOutput();
+  t.direction = motor.getDirection();
+
+  t.steering = steeringCommand;
+  t.driveMode = motor.getDriveMode();
+  t.left = motor.getAppliedOutput(MotorManager::CHANNEL_LEFT);
+  t.right = motor.getAppliedOutput(MotorManager::CHANNEL_RIGHT);
+  t.speedLeft = motor.getMeasuredSpeed(MotorManager::CHANNEL_LEFT);
+  t.speedRight = motor.getMeasuredSpeed(MotorManager::CHANNEL_RIGHT);
+
+  int32_t rssi = wifi.getRSSI();
+  t.rssi = (int8_t)constrain(rssi, -128, 0);
+  t.staleFrames = (uint16_t)staleControlFrames;
+  t.queueDepth = commands.depth();
+  t.queueCoalesced = (uint16_t)commands.getCoalesced();
+}
+
 void StateManager::setBootStep(BootStep s) {
   bootStep = s;
 
@@ -137,5 +536,5 @@ void StateManager::setBootStep(BootStep s) {
       display.setStat(DisplayManager::WEBSERVER_READY);
       break;
   }
-  display.update(0);
+  display.flush();
 }
\ No newline at end of file
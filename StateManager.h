@@ -3,11 +3,18 @@
 
 #include <Arduino.h>
 #include "BasicManager.h"
-#include "WiFiManager.h"
+#include "WIFIManager.h"
 #include "WebServerManager.h"
 #include "DisplayManager.h"
 #include "MotorManager.h"
 #include "ServoManager.h"
+#include "UdpControlManager.h"
+#include "Scheduler.h"
+#include "ControlFrame.h"
+#include "LogManager.h"
+#include "FailsafeManager.h"
+#include "FlightRecorder.h"
+#include "CommandQueue.h"
 
 enum BootStep {
   BOOT_START = 0,
@@ -28,23 +35,111 @@ class StateManager {
     BootStep getBootStep() const;
     String getIPAddress() const;
 
-    void cmd_setMotorSpeed(uint8_t rate);
-    void cmd_setMotorDir(int dir);
-    void cmd_setSteering(int angle);
+    // false when refused: failsafe tripped, queue full, or (tank) not in tank mode
+    bool cmd_setMotorSpeed(uint8_t rate);
+    bool cmd_setMotorDir(int dir);
+    bool cmd_setSteering(int angle);
+    bool cmd_setDriveMode(int mode);
+    bool cmd_setTank(int left, int right);
+    void cmd_heartbeat();
+    bool cmd_arm(); // false if the failsafe cannot be re-armed yet
+    bool cmd_applyControl(const ControlFrame& frame,
+                          FlightRecorder::Source source = FlightRecorder::SOURCE_WEB,
+                          uint8_t channel = WebServerManager::CONTROL_HTTP);
+
+    // control channels, each with its own ControlFrame sequence: the web
+    // server's, then UDP
+    static const uint8_t CONTROL_UDP = WebServerManager::CONTROL_CHANNELS;
+    static const uint8_t CONTROL_CHANNELS = CONTROL_UDP + 1;
+
+    void fillTelemetry(TelemetryFrame& t) const;
+    const Scheduler& getScheduler() const;
+
+    // compact text dump of timings and counters (GET /metrics, "metrics" on serial)
+    size_t formatMetrics(char* out, size_t size) const;
+    // one server-sent event with the live state as JSON (GET /events)
+    size_t formatEvent(char* out, size_t size) const;
+    // flight recorder dump (GET /recorder, "recorder" on serial); size only when out is null
+    size_t dumpRecorder(Print* out) const;
+    const FlightRecorder& getRecorder() const;
 
   private:
     StateManager();
 
+    // StateManager's own bookkeeping, run as a scheduler task
+    class StatusTask : public BasicManager {
+      public:
+        void init() override { initialized = true; }
+        void update(unsigned long now) override;
+    };
+
+    // samples the actuators every pass, after motor and servo had their turn
+    class RecorderTask : public BasicManager {
+      public:
+        void init() override { initialized = true; }
+        void update(unsigned long now) override;
+    };
+
+    // applies queued commands once per control cycle, just before the motor task
+    class CommandTask : public BasicManager {
+      public:
+        void init() override { initialized = true; }
+        void update(unsigned long now) override;
+    };
+
     WiFiManager wifi;
     WebServerManager server;
+    UdpControlManager udp;
     DisplayManager display;
     MotorManager motor;
     ServoManager servo;
+    StatusTask status;
+    RecorderTask recorderTask;
+    CommandTask commandTask;
+    CommandQueue commands; // network front-ends -> actuators
+    FlightRecorder recorder;
+    FailsafeManager failsafe;
+
+    Scheduler scheduler;
 
     BootStep bootStep = BOOT_START;
     unsigned long lastUpdateMs = 0;
 
+    // last applied ControlFrame sequence, per channel for the stale check
+    // and from any channel for the acks
+    struct ControlSeq {
+      bool have = false;
+      uint16_t seq = 0;
+    };
+    ControlSeq controlSeq[CONTROL_CHANNELS];
+    bool haveControlSeq = false;
+    uint16_t lastControlSeq = 0;
+    uint32_t staleControlFrames = 0;
+    unsigned long lastControlMs = 0; // when lastControlSeq was applied
+
+    // steering as commanded, whichever actuator ends up carrying it
+    int8_t steeringCommand = 0;
+    // drive mode as last queued, ahead of the command task applying it;
+    // back to the applied one whenever the queue is voided
+    DriveMixer::Mode driveModeCommand = DriveMixer::SERVO_ONLY;
+
+    // serial console line being typed
+    static const uint8_t CONSOLE_LINE = 16;
+    char consoleLine[CONSOLE_LINE + 1];
+    uint8_t consoleLen = 0;
+
+    void applyCommands();
+    void applySteering(int8_t steering);
+    void applyDirection(int dir);
+    bool acceptCommand();
+    void voidQueuedCommands();
+    void noteControlSeq(ControlSeq& last, uint16_t seq);
+    bool rearm();
+    void onFailsafeTrip();
     void setBootStep(BootStep s);
+    void refreshStatus(unsigned long now);
+    void onLinkChange(bool up);
+    void pollConsole();
 };
 
 #endif
@@ -0,0 +1,82 @@
+#include "UdpControlManager.h"
+
+void UdpControlManager::init() {
+  udp.begin(CONTROL_PORT);
+  initialized = true;
+}
+
+void UdpControlManager::update(unsigned long now) {
+  if (!initialized) return;
+
+  // drain what queued up since the last pass: plain frames collapse into the
+  // newest one, flagged ones (resync, estop, arm) are applied in arrival
+  // order and never dropped
+  ControlFrame latest;
+  bool haveLatest = false;
+  IPAddress senderIp;
+  uint16_t senderPort = 0;
+
+  for (uint8_t i = 0; i < MAX_DATAGRAMS_PER_UPDATE; ++i) {
+    int size = udp.parsePacket();
+    if (size <= 0) break;
+
+    uint8_t buf[ControlFrame::WIRE_SIZE];
+    ControlFrame frame;
+    if (size != (int)sizeof(buf) ||
+        udp.read(buf, sizeof(buf)) != (int)sizeof(buf) ||
+        !ControlFrame::decode(buf, sizeof(buf), frame)) {
+      rejected++;
+      continue;
+    }
+    received++;
+
+    if (frame.flags != 0) {
+      if (haveLatest) apply(latest, senderIp, senderPort);
+      haveLatest = false;
+      apply(frame, udp.remoteIP(), udp.remotePort());
+      continue;
+    }
+    if (!haveLatest || (int16_t)(frame.seq - latest.seq) > 0) {
+      latest = frame;
+      haveLatest = true;
+      senderIp = udp.remoteIP();
+      senderPort = udp.remotePort();
+    }
+  }
+
+  if (haveLatest) apply(latest, senderIp, senderPort);
+}
+
+void UdpControlManager::apply(const ControlFrame& frame, const IPAddress& ip, uint16_t port) {
+  bool applied = controlFrameCallback && controlFrameCallback(frame);
+  sendTelemetry(ip, port, applied);
+}
+
+void UdpControlManager::attachControlFrameCallback(bool (*cb)(const ControlFrame&)) {
+  controlFrameCallback = cb;
+}
+
+void UdpControlManager::attachTelemetryCallback(void (*cb)(TelemetryFrame&)) {
+  telemetryCallback = cb;
+}
+
+uint32_t UdpControlManager::getReceived() const {
+  return received;
+}
+
+uint32_t UdpControlManager::getRejected() const {
+  return rejected;
+}
+
+void UdpControlManager::sendTelemetry(IPAddress ip, uint16_t port, bool applied) {
+  TelemetryFrame telemetry;
+  if (telemetryCallback) telemetryCallback(telemetry);
+  if (applied) telemetry.flags |= TelemetryFrame::FLAG_APPLIED;
+
+  uint8_t buf[TelemetryFrame::WIRE_SIZE];
+  telemetry.encode(buf);
+
+  udp.beginPacket(ip, port);
+  udp.write(buf, sizeof(buf));
+  udp.endPacket();
+}
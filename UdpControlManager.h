@@ -0,0 +1,40 @@
+#ifndef UDP_CONTROL_MANAGER_H
+#define UDP_CONTROL_MANAGER_H
+
+#include "BasicManager.h"
+#include "ControlFrame.h"
+#include <WiFiS3.h>
+
+// Low-latency ControlFrame datagrams, answered with a TelemetryFrame
+class UdpControlManager : public BasicManager {
+  public:
+    static const uint16_t CONTROL_PORT = 4210;
+
+    void init() override;
+    void update(unsigned long now) override;
+
+    // returns true when the frame was applied
+    void attachControlFrameCallback(bool (*cb)(const ControlFrame&));
+    void attachTelemetryCallback(void (*cb)(TelemetryFrame&));
+
+    uint32_t getReceived() const;
+    uint32_t getRejected() const;
+
+  private:
+    // datagrams read per update; older unflagged ones in a batch are superseded
+    static const uint8_t MAX_DATAGRAMS_PER_UPDATE = 8;
+
+    WiFiUDP udp;
+
+    bool (*controlFrameCallback)(const ControlFrame&) = nullptr;
+    void (*telemetryCallback)(TelemetryFrame&) = nullptr;
+
+    uint32_t received = 0;
+    uint32_t rejected = 0;
+
+    // hands one frame to the callback and answers its sender
+    void apply(const ControlFrame& frame, const IPAddress& ip, uint16_t port);
+    void sendTelemetry(IPAddress ip, uint16_t port, bool applied);
+};
+
+#endif
@@ -3,37 +3,116 @@
 void WiFiManager::init(const char* ssid, const char* pass) {
   _ssid = ssid;
   _pass = pass;
+  init();
 }
 
-bool WiFiManager::connect() {
-  WiFi.begin(_ssid, _pass);
+void WiFiManager::init() {
+  initialized = true;
+  // backoff jitter must differ from car to car, and random() starts every
+  // board on the same sequence; seed it from a floating pin and the boot time
+  unsigned long seed = micros();
+  for (uint8_t i = 0; i < 16; ++i) seed = seed * 31 + analogRead(ENTROPY_PIN);
+  randomSeed(seed);
 
-  unsigned long startAttempt = millis();
-  while (WiFi.status() != WL_CONNECTED && millis() - startAttempt < 5000) {
-    delay(200);
-  }
+  // WiFiS3's begin() hands the join to the modem, then polls it until joined
+  // or its timeout (10 s by default) runs out. With no wait it returns after
+  // the one AT round trip, and CONNECTING polls WiFi.status() instead
+  WiFi.setTimeout(JOIN_WAIT_MS);
+  connect();
+}
 
-  _connected = (WiFi.status() == WL_CONNECTED);
-  return _connected;
+void WiFiManager::connect() {
+  WiFi.begin(_ssid, _pass); // returns before the join completes
+  _state = LINK_CONNECTING;
+  _attemptStart = millis();
 }
 
 void WiFiManager::update(unsigned long now) {
-  if (!_connected) {
-    // if not connected to wifi, retry every 5 seconds
-    if (now - _lastRetry >= RETRY_INTERVAL) {
+  if (!initialized) return;
+  uint8_t status = WiFi.status();
+
+  switch (_state) {
+    case LINK_IDLE:
       connect();
-      _lastRetry = now;
-    }
-  } else {
-    _connected = (WiFi.status() == WL_CONNECTED);
+      break;
+
+    case LINK_CONNECTING:
+      if (status == WL_CONNECTED) {
+        _attempts = 0;
+        _state = LINK_UP;
+        _rssi = WiFi.RSSI();
+        setConnected(true);
+      } else if (status == WL_CONNECT_FAILED || status == WL_NO_SSID_AVAIL ||
+                 now - _attemptStart >= CONNECT_TIMEOUT) {
+        WiFi.disconnect();
+        scheduleRetry(now);
+      }
+      break;
+
+    case LINK_UP:
+      if (status == WL_CONNECTED) {
+        // the one modem round trip for RSSI; telemetry reads the cached value
+        _rssi = WiFi.RSSI();
+      } else {
+        setConnected(false);
+        // retry from a later tick so the motor task gets the stop onto the
+        // bridge first. Back off only if that fails too
+        _retryAt = now + LOSS_RETRY_DELAY;
+        _state = LINK_BACKOFF;
+      }
+      break;
+
+    case LINK_BACKOFF:
+      if ((long)(now - _retryAt) >= 0) connect();
+      break;
   }
 }
 
+void WiFiManager::attachLinkCallback(void (*cb)(bool)) {
+  linkCallback = cb;
+}
+
 bool WiFiManager::isConnected() const {
   return _connected;
 }
 
+WiFiManager::LinkState WiFiManager::getState() const {
+  return _state;
+}
+
+uint16_t WiFiManager::getAttempts() const {
+  return _attempts;
+}
+
+int32_t WiFiManager::getRSSI() const {
+  if (!_connected) return 0;
+  return _rssi;
+}
+
 String WiFiManager::getIPAddress() const {
   if (!_connected) return "";
   return WiFi.localIP().toString();
-}
\ No newline at end of file
+}
+
+IPAddress WiFiManager::getLocalIP() const {
+  if (!_connected) return IPAddress(0, 0, 0, 0);
+  return WiFi.localIP();
+}
+
+void WiFiManager::setConnected(bool up) {
+  if (_connected == up) return;
+  _connected = up;
+  if (linkCallback) linkCallback(up);
+}
+
+void WiFiManager::scheduleRetry(unsigned long now) {
+  // exponential backoff with up to 25% jitter so several cars don't retry in step
+  uint8_t shift = _attempts < 6 ? _attempts : 6;
+  unsigned long delayMs = BACKOFF_BASE << shift;
+  if (delayMs > BACKOFF_MAX) delayMs = BACKOFF_MAX;
+  delayMs += random(delayMs / 4 + 1);
+
+  if (_attempts < 0xFFFF) _attempts++;
+  _retryAt = now + delayMs;
+  _state = LINK_BACKOFF;
+}
@@ -3,23 +3,52 @@
 
 #include <Arduino.h>
 #include <WiFiS3.h>
+#include "BasicManager.h"
 
-class WiFiManager {
+class WiFiManager : public BasicManager {
   public:
+    enum LinkState {LINK_IDLE = 0, LINK_CONNECTING, LINK_UP, LINK_BACKOFF};
+
+    static const unsigned long JOIN_WAIT_MS = 0; // time WiFi.begin() may wait for the join
+
     void init(const char* ssid, const char* pass);
-    bool connect();
-    void update(unsigned long now);
+    void init() override;
+    void connect(); // starts association, never waits for it
+    void update(unsigned long now) override;
+
+    // called on every up/down transition
+    void attachLinkCallback(void (*cb)(bool up));
 
     bool isConnected() const;
+    LinkState getState() const;
+    uint16_t getAttempts() const;
     String getIPAddress() const;
+    IPAddress getLocalIP() const;
+    // as of the last wifi task tick (1 Hz); 0 while down. Cheap, unlike
+    // WiFi.RSSI(), which is a round trip to the modem
+    int32_t getRSSI() const;
 
   private:
     const char* _ssid;
     const char* _pass;
 
+    LinkState _state = LINK_IDLE;
     bool _connected = false;
-    unsigned long _lastRetry = 0;
-    const unsigned long RETRY_INTERVAL = 5000; // retry every 5 seconds
+    unsigned long _attemptStart = 0;
+    unsigned long _retryAt = 0;
+    uint16_t _attempts = 0; // failed attempts since the link was last up
+    int32_t _rssi = 0;
+
+    static const uint8_t ENTROPY_PIN = A0;       // left unconnected, seeds the jitter
+    const unsigned long CONNECT_TIMEOUT = 10000;
+    const unsigned long BACKOFF_BASE = 500;    // doubles per failed attempt
+    const unsigned long BACKOFF_MAX = 30000;
+    const unsigned long LOSS_RETRY_DELAY = 1;  // ms; the next wifi tick after a link loss
+
+    void (*linkCallback)(bool) = nullptr;
+
+    void setConnected(bool up);
+    void scheduleRetry(unsigned long now);
 };
 
-#endif
\ No newline at end of file
+#endif
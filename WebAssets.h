@@ -0,0 +1,312 @@
+// Generated by tools/gen_assets.py from web/ -- do not edit.
+#ifndef WEB_ASSETS_H
+#define WEB_ASSETS_H
+
+#include <Arduino.h>
+
+struct WebAsset {
+  const char* path;
+  const char* contentType;
+  const uint8_t* data; // gzip stream
+  size_t len;
+  const char* etag;    // quoted, strong
+};
+
+// index.html: 12433 bytes, 4598 gzipped
+static const uint8_t ASSET_INDEX_HTML[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xad, 0x5b, 0xe9, 0x72, 0x1b, 0x49,
+  0x72, 0xfe, 0x8f, 0xa7, 0xe8, 0x81, 0x34, 0x6a, 0x60, 0xa7, 0x71, 0xf2, 0x10, 0x05, 0xb0, 0xa1,
+  0xe0, 0xf0, 0xd8, 0xe5, 0xae, 0x0e, 0x06, 0x41, 0xcd, 0xc4, 0x84, 0x82, 0x16, 0x1b, 0xe8, 0x6a,
+  0xa0, 0x97, 0x7d, 0xa9, 0xab, 0x9a, 0x20, 0x16, 0x42, 0x84, 0x9f, 0xc1, 0x8e, 0xf0, 0x46, 0xf8,
+  0x8f, 0xc3, 0xaf, 0xe0, 0x1f, 0xf6, 0x1f, 0x3f, 0xcd, 0x3e, 0x81, 0x1f, 0xc1, 0x99, 0x59, 0xd5,
+  0x27, 0x00, 0x8a, 0x1b, 0xf6, 0x2a, 0x06, 0xec, 0xae, 0xca, 0xca, 0xca, 0xf3, 0xcb, 0xac, 0x02,
+  0xf6, 0xf8, 0x87, 0xb3, 0x8f, 0xa7, 0x37, 0xbf, 0x5d, 0x9d, 0x6b, 0x73, 0xe1, 0x7b, 0xa3, 0xda,
+  0x31, 0xfe, 0xd1, 0x3c, 0x2b, 0x98, 0x99, 0x75, 0x16, 0xd4, 0x71, 0x80, 0x59, 0x36, 0xfc, 0xf1,
+  0x99, 0xb0, 0xb4, 0xe9, 0xdc, 0x8a, 0x39, 0x13, 0x66, 0xfd, 0xd3, 0xcd, 0x45, 0xeb, 0xa8, 0x9e,
+  0x0e, 0x07, 0x96, 0xcf, 0xcc, 0xfa, 0x83, 0xcb, 0x16, 0x51, 0x18, 0x8b, 0xba, 0x36, 0x0d, 0x03,
+  0xc1, 0x02, 0x20, 0x5b, 0xb8, 0xb6, 0x98, 0x9b, 0x36, 0x7b, 0x70, 0xa7, 0xac, 0x45, 0x2f, 0x86,
+  0x1b, 0xb8, 0xc2, 0xb5, 0xbc, 0x16, 0x9f, 0x5a, 0x1e, 0x33, 0x7b, 0xed, 0x2e, 0x72, 0x11, 0xae,
+  0xf0, 0xd8, 0xe8, 0xfa, 0x54, 0x3b, 0xb5, 0x62, 0xed, 0x14, 0x56, 0xc7, 0xa1, 0x77, 0xdc, 0x91,
+  0xa3, 0xb5, 0x63, 0x2e, 0x96, 0xf8, 0xf7, 0x77, 0x2b, 0xdf, 0x8a, 0x67, 0x6e, 0x30, 0xe8, 0x0e,
+  0x23, 0xcb, 0xb6, 0xdd, 0x60, 0x06, 0x4f, 0x93, 0xf0, 0xb1, 0xc5, 0xdd, 0xbf, 0xe0, 0xcb, 0x24,
+  0x8c, 0x6d, 0x16, 0xb7, 0x60, 0x64, 0x5d, 0x9b, 0x84, 0xf6, 0x72, 0xe5, 0x00, 0xa3, 0x96, 0x63,
+  0xf9, 0xae, 0xb7, 0x1c, 0x9c, 0xc4, 0xb0, 0xa9, 0xc1, 0xad, 0x80, 0xb7, 0x38, 0x8b, 0x5d, 0x67,
+  0x38, 0xb1, 0xa6, 0xf7, 0xb3, 0x38, 0x4c, 0x02, 0x7b, 0xe0, 0xb9, 0x01, 0xb3, 0xe2, 0xd6, 0x2c,
+  0xb6, 0x6c, 0x17, 0xc4, 0x6e, 0xf4, 0xf6, 0x0e, 0x6c, 0x36, 0x33, 0x5e, 0x1c, 0x1e, 0xbe, 0x66,
+  0xcc, 0xd2, 0xba, 0x3f, 0x1a, 0x2f, 0x5e, 0x1f, 0xee, 0x4f, 0xac, 0xbe, 0xd6, 0xeb, 0x76, 0x7f,
+  0x6c, 0x0e, 0x7d, 0x37, 0x68, 0xcd, 0x99, 0x3b, 0x9b, 0x8b, 0x01, 0x0c, 0x3c, 0xcc, 0x33, 0x71,
+  0xfa, 0xdd, 0x08, 0xf6, 0x6e, 0xa3, 0xfa, 0x16, 0xf0, 0x8c, 0x41, 0xe0, 0x47, 0xa9, 0xf6, 0xe0,
+  0xa8, 0x0b, 0x73, 0xc3, 0x54, 0x01, 0xcd, 0x4a, 0x44, 0x58, 0x14, 0xe1, 0x85, 0xe3, 0x80, 0x48,
+  0x52, 0x01, 0x14, 0x23, 0xe1, 0xc4, 0x4c, 0xaa, 0x37, 0xb7, 0xec, 0x70, 0x01, 0x8b, 0x70, 0x44,
+  0x3b, 0xc4, 0x8f, 0x78, 0x36, 0xb1, 0x1a, 0x5d, 0x83, 0xfe, 0xb5, 0xf7, 0x9a, 0xc3, 0xf0, 0x81,
+  0xc5, 0x8e, 0x07, 0x44, 0x73, 0xd7, 0xb6, 0x59, 0x00, 0x32, 0xa0, 0xd7, 0x40, 0x80, 0xff, 0x83,
+  0x96, 0xd3, 0xd0, 0x0b, 0x63, 0x29, 0x58, 0x51, 0xbf, 0xa1, 0x60, 0x8f, 0xa2, 0x65, 0x79, 0xee,
+  0x2c, 0x18, 0x4c, 0x81, 0x0f, 0x8b, 0xd7, 0xb5, 0x79, 0x4f, 0xda, 0x1a, 0x1c, 0xc1, 0x06, 0xfd,
+  0xa3, 0x4c, 0x51, 0xf0, 0x85, 0x10, 0xa1, 0x3f, 0x38, 0x20, 0xb3, 0x70, 0x61, 0x89, 0x84, 0x17,
+  0x28, 0x7b, 0xfb, 0x40, 0x19, 0x46, 0xd6, 0xd4, 0x15, 0xcb, 0x41, 0xb7, 0xfd, 0x06, 0x4d, 0x07,
+  0x91, 0x14, 0x5b, 0xe0, 0xa2, 0xa9, 0x70, 0xc3, 0xa0, 0x28, 0xfe, 0x8b, 0x6e, 0x17, 0xfc, 0x1e,
+  0x72, 0x17, 0x27, 0x06, 0x31, 0xf3, 0x2c, 0xe1, 0x3e, 0xb0, 0x54, 0xb4, 0x6c, 0xa7, 0xc3, 0x76,
+  0xff, 0xe0, 0xc7, 0x4d, 0x7b, 0xbc, 0x90, 0x8c, 0xc7, 0x22, 0x66, 0x96, 0xbf, 0xca, 0xd8, 0x58,
+  0x13, 0x1e, 0x7a, 0x89, 0x60, 0x43, 0x11, 0x46, 0x10, 0x4c, 0x1e, 0x73, 0x04, 0xfc, 0x91, 0x1e,
+  0x43, 0x2b, 0x0c, 0x73, 0x37, 0x03, 0xd3, 0xc9, 0x9f, 0x41, 0xac, 0x96, 0xe3, 0x8a, 0x81, 0xf2,
+  0x70, 0x2e, 0x70, 0xe8, 0x38, 0x68, 0xdf, 0x1d, 0x9c, 0x0f, 0x60, 0x35, 0xf1, 0xc6, 0x07, 0x11,
+  0x43, 0x10, 0x3a, 0x61, 0xec, 0x0f, 0xe8, 0x09, 0xf4, 0x60, 0x8d, 0x16, 0x4c, 0x18, 0xf8, 0x91,
+  0x99, 0xfd, 0xf0, 0xf0, 0x70, 0xd3, 0xd2, 0xc3, 0x82, 0xed, 0x8e, 0xb2, 0x50, 0x83, 0x5c, 0xc9,
+  0x0c, 0x96, 0x7a, 0x6a, 0x4f, 0x46, 0xa2, 0x1f, 0x8a, 0x30, 0x6e, 0x29, 0xa2, 0x55, 0xd9, 0x29,
+  0x8a, 0x84, 0x7b, 0x2e, 0x06, 0x5d, 0x31, 0x66, 0x89, 0x0a, 0xe5, 0xee, 0x91, 0xe3, 0x3c, 0x6b,
+  0xc2, 0xbc, 0x95, 0xed, 0xf2, 0xc8, 0xb3, 0x96, 0x83, 0x89, 0x17, 0x4e, 0xef, 0xa5, 0x20, 0x0b,
+  0x69, 0x9c, 0x43, 0x70, 0x4c, 0x99, 0x75, 0x0f, 0xe3, 0x44, 0x29, 0xb2, 0xb7, 0xb7, 0xb7, 0xae,
+  0xb9, 0x41, 0x94, 0x88, 0xcf, 0x62, 0x19, 0x01, 0x4c, 0x80, 0xd2, 0x33, 0x56, 0xbf, 0x5d, 0x6d,
+  0x5a, 0xf9, 0x88, 0x02, 0xbe, 0x98, 0x03, 0x07, 0x38, 0x52, 0x88, 0x01, 0xdb, 0xb6, 0x87, 0x61,
+  0x22, 0xd0, 0xd4, 0x83, 0x20, 0x0c, 0xd8, 0x10, 0x64, 0x98, 0xdc, 0xbb, 0x60, 0xa5, 0x28, 0x82,
+  0xe0, 0xb6, 0x82, 0xa9, 0x1c, 0xdf, 0xba, 0xe3, 0x60, 0x90, 0x52, 0x2b, 0x9d, 0xc5, 0x3c, 0xf1,
+  0x27, 0xab, 0x1d, 0x2c, 0x54, 0x14, 0xf4, 0x31, 0x46, 0x95, 0x7c, 0xf4, 0x5c, 0x11, 0x10, 0xa4,
+  0x2f, 0x0a, 0x28, 0x93, 0x69, 0x38, 0x4d, 0x62, 0x0e, 0xca, 0x47, 0xa1, 0x4b, 0x6e, 0x2b, 0x67,
+  0x31, 0xe4, 0xef, 0x41, 0x35, 0x87, 0xfb, 0xcd, 0x5d, 0x22, 0xfb, 0xe1, 0x5f, 0x5a, 0xf4, 0xa6,
+  0xc4, 0xfd, 0x7f, 0x15, 0x0b, 0xd7, 0x48, 0x6d, 0x9f, 0x27, 0x62, 0x1a, 0x2d, 0x0f, 0x96, 0x97,
+  0xb0, 0xd5, 0x53, 0xf1, 0x49, 0x42, 0x15, 0xa3, 0x64, 0x12, 0x7a, 0x76, 0x1e, 0xdc, 0x24, 0x4e,
+  0x31, 0xd2, 0x64, 0x30, 0xda, 0x6e, 0x2c, 0x03, 0x39, 0x8d, 0x59, 0xbe, 0xda, 0x02, 0x37, 0x05,
+  0xb2, 0x59, 0xec, 0xda, 0x59, 0x68, 0xba, 0x01, 0x06, 0x06, 0x8d, 0x0d, 0xf1, 0xa3, 0x25, 0x98,
+  0x1f, 0x61, 0x7e, 0x01, 0x37, 0x2f, 0xf1, 0x03, 0x0e, 0xb0, 0x01, 0x3e, 0x16, 0x8d, 0x3d, 0xe3,
+  0x08, 0xf6, 0x6b, 0x56, 0x88, 0xe2, 0x70, 0xb1, 0x49, 0x61, 0x49, 0xd9, 0x86, 0x1b, 0x59, 0xd1,
+  0xb6, 0x62, 0x58, 0xd0, 0x9a, 0x88, 0xe0, 0x49, 0x90, 0xdd, 0x97, 0x20, 0xeb, 0x74, 0xf1, 0x9f,
+  0x01, 0x30, 0x84, 0xff, 0x9a, 0x15, 0xd3, 0x17, 0x5d, 0x87, 0xdc, 0x0b, 0x76, 0xdc, 0xeb, 0x63,
+  0x2a, 0x95, 0xfd, 0x46, 0xb8, 0xa1, 0x60, 0xc6, 0xf3, 0xb4, 0x6e, 0xbb, 0xc7, 0x8b, 0xfe, 0x3b,
+  0x50, 0xde, 0x43, 0xb9, 0xb5, 0x17, 0x93, 0x23, 0xfc, 0x07, 0xe0, 0x02, 0x2f, 0xad, 0x7c, 0x18,
+  0x61, 0x3d, 0xb5, 0x9b, 0xe3, 0xb1, 0xc7, 0x21, 0x99, 0xb8, 0xe5, 0x82, 0x35, 0x78, 0xea, 0xcd,
+  0x3f, 0x27, 0x5c, 0xb8, 0xce, 0xb2, 0xa5, 0xca, 0x79, 0x3a, 0x9c, 0x40, 0x01, 0x05, 0xc0, 0xf1,
+  0xc0, 0x05, 0x2a, 0xd9, 0x72, 0x5b, 0x0c, 0xe6, 0x08, 0xbd, 0xcf, 0xb1, 0x88, 0xb4, 0x44, 0x6a,
+  0x99, 0x66, 0x91, 0x49, 0x3b, 0x8a, 0x19, 0xe7, 0xcc, 0x7e, 0x0e, 0x1b, 0x19, 0x4a, 0x69, 0xe9,
+  0x2a, 0x55, 0xad, 0x82, 0x49, 0xdc, 0x00, 0xba, 0x16, 0x6d, 0x0f, 0x14, 0xc7, 0xff, 0x5e, 0xa3,
+  0x01, 0x0e, 0x0e, 0x0e, 0x8f, 0xa6, 0xfb, 0x86, 0x9c, 0x69, 0xe1, 0x70, 0x2b, 0x9b, 0x7b, 0xfd,
+  0xfa, 0xcd, 0x3e, 0x30, 0xc8, 0x91, 0x9a, 0x9a, 0x95, 0x06, 0x94, 0xa8, 0x83, 0x92, 0xa0, 0x03,
+  0x6b, 0x8a, 0x45, 0x68, 0xb5, 0x83, 0xf0, 0x45, 0x12, 0xfd, 0x0c, 0xe1, 0x41, 0x51, 0x26, 0x23,
+  0x70, 0xd0, 0x97, 0x31, 0x07, 0xeb, 0x07, 0x3d, 0x20, 0xc0, 0xa2, 0x50, 0x25, 0xe9, 0xe5, 0x24,
+  0x7d, 0x20, 0xe1, 0x10, 0x72, 0x4f, 0x70, 0xe9, 0x0f, 0x9f, 0x13, 0x7d, 0xce, 0xe1, 0xe4, 0x70,
+  0x62, 0xbc, 0x60, 0xec, 0x00, 0xfe, 0x57, 0x32, 0x52, 0x21, 0x63, 0xbb, 0x5b, 0x32, 0x16, 0x04,
+  0x88, 0xf1, 0xa5, 0x2a, 0xc1, 0x5e, 0x59, 0x48, 0xb0, 0x71, 0xf0, 0x84, 0x90, 0x50, 0x01, 0xda,
+  0xf7, 0x6c, 0x39, 0x09, 0xad, 0xd8, 0x6e, 0xcd, 0x21, 0x88, 0x8b, 0x45, 0x66, 0x7b, 0x53, 0x51,
+  0xac, 0x83, 0xe5, 0x8e, 0x41, 0x56, 0x3d, 0xc7, 0x9d, 0x65, 0x45, 0xaf, 0xca, 0x2c, 0x2d, 0x82,
+  0xbd, 0x6a, 0xf9, 0x70, 0x0e, 0xf0, 0x5f, 0x35, 0xe1, 0xba, 0x45, 0x9e, 0x04, 0xc2, 0xab, 0x52,
+  0x66, 0x6c, 0xc5, 0x00, 0x5a, 0x54, 0x44, 0x6c, 0xd4, 0x00, 0xaa, 0x1a, 0xae, 0x00, 0x17, 0x66,
+  0x22, 0x74, 0x33, 0x6c, 0x1e, 0x20, 0xaa, 0x42, 0x53, 0xe0, 0xda, 0x1a, 0xd5, 0xb1, 0xb2, 0x14,
+  0x47, 0xa5, 0xac, 0x97, 0x7a, 0x4e, 0x12, 0xa8, 0xa6, 0x79, 0x4d, 0xa7, 0xc4, 0x95, 0x5d, 0xe1,
+  0x16, 0x68, 0x2f, 0xc6, 0xfd, 0x2e, 0x6c, 0x39, 0xda, 0xc4, 0x92, 0x6a, 0x21, 0x2f, 0x60, 0x4b,
+  0xbe, 0x0b, 0x40, 0xcc, 0x1e, 0x4f, 0xe5, 0xd9, 0x4c, 0x71, 0x95, 0x4b, 0x10, 0x07, 0x56, 0xec,
+  0x63, 0x18, 0x14, 0x0d, 0x85, 0xf8, 0x95, 0x97, 0x7a, 0x30, 0xb4, 0x00, 0xe4, 0x80, 0x53, 0x43,
+  0xbc, 0xcc, 0xac, 0xfc, 0x7d, 0xc0, 0xde, 0x37, 0x7a, 0x4e, 0x2c, 0xd1, 0x78, 0xb3, 0xbb, 0x54,
+  0x8d, 0x4c, 0xc6, 0x57, 0xb3, 0xdd, 0x87, 0xd5, 0x77, 0xdd, 0x7e, 0x54, 0x08, 0x94, 0xa3, 0xad,
+  0x11, 0x58, 0x70, 0xc7, 0x5e, 0xde, 0xcf, 0x40, 0x40, 0x96, 0x36, 0x9b, 0x6c, 0xeb, 0x8c, 0xe4,
+  0xaa, 0xc3, 0x52, 0x17, 0x54, 0x0c, 0x9f, 0xfd, 0x8a, 0xc4, 0x93, 0x36, 0xc0, 0x46, 0x2c, 0x56,
+  0x99, 0x17, 0x31, 0x5f, 0xd7, 0xb5, 0xe3, 0x8e, 0x3a, 0xfa, 0x1c, 0x77, 0xd4, 0x29, 0x0c, 0xcf,
+  0x35, 0xf0, 0x07, 0x34, 0xd4, 0xa6, 0x9e, 0xc5, 0xb9, 0x59, 0xcf, 0x1a, 0xb7, 0x7a, 0x79, 0x5c,
+  0x1e, 0x00, 0xe8, 0x00, 0xd7, 0x1b, 0xfd, 0xcf, 0xbf, 0xfd, 0xeb, 0x5f, 0xb5, 0xea, 0xf1, 0x0a,
+  0xc6, 0x4b, 0x2b, 0x64, 0x7f, 0x5e, 0xd7, 0x5c, 0x3b, 0x7d, 0xbe, 0xc1, 0x98, 0x1e, 0x5d, 0x03,
+  0xa7, 0xe5, 0x71, 0x07, 0x28, 0x51, 0x10, 0xf9, 0xa7, 0x28, 0x40, 0xa9, 0x65, 0xc7, 0x0d, 0x5d,
+  0x7f, 0x46, 0x4c, 0x8a, 0x3d, 0x77, 0x5d, 0xe3, 0xf1, 0xd4, 0xac, 0xd7, 0x35, 0xcb, 0x83, 0x73,
+  0xe1, 0x29, 0xcd, 0x68, 0x6a, 0x6a, 0x2b, 0x3f, 0xd5, 0x51, 0xd7, 0x0b, 0x9c, 0x3e, 0xaa, 0x21,
+  0x50, 0xe7, 0x9f, 0xff, 0x4b, 0x53, 0x3c, 0xd4, 0xe0, 0xf1, 0x24, 0x1e, 0x1d, 0x73, 0x1f, 0xea,
+  0xe1, 0xe8, 0x94, 0x32, 0x39, 0x89, 0x99, 0x76, 0x3e, 0xbe, 0xda, 0xeb, 0xb7, 0x4e, 0x4f, 0xde,
+  0x6b, 0x97, 0x57, 0x1a, 0x34, 0xb1, 0xe1, 0x02, 0x2c, 0x4a, 0x34, 0x4f, 0xa8, 0x53, 0xee, 0xa8,
+  0x2b, 0xc2, 0x65, 0x2e, 0x53, 0xe3, 0xa3, 0xb3, 0x18, 0x0a, 0xc0, 0xf1, 0x84, 0xa4, 0x14, 0xf4,
+  0x52, 0x1f, 0xb5, 0x8e, 0x3b, 0x93, 0x51, 0x81, 0xf5, 0xe8, 0xd7, 0x39, 0x63, 0x1e, 0xd7, 0xde,
+  0x75, 0xae, 0x53, 0x4a, 0x39, 0xb2, 0x85, 0x74, 0x2c, 0x18, 0x1c, 0x4f, 0x83, 0x59, 0x4a, 0x48,
+  0xef, 0x5b, 0xe8, 0x2e, 0x2c, 0xd7, 0xe3, 0x96, 0x93, 0x6d, 0x7d, 0xb1, 0x8d, 0xd9, 0x35, 0x25,
+  0xaf, 0x88, 0xdd, 0x28, 0x25, 0xbb, 0x16, 0x62, 0x0b, 0xdd, 0xa9, 0x6f, 0x6b, 0x98, 0x76, 0xc1,
+  0x74, 0x99, 0x12, 0xc2, 0xd0, 0x16, 0xc2, 0x77, 0x61, 0x18, 0x69, 0xd1, 0x9b, 0x37, 0x29, 0x15,
+  0xbe, 0x6f, 0xdb, 0x77, 0x3c, 0xbe, 0xcc, 0x76, 0xe4, 0xdc, 0xad, 0x90, 0x6c, 0x35, 0x7a, 0x01,
+  0xd0, 0xd1, 0xb6, 0x74, 0xe8, 0x18, 0x95, 0x1c, 0x78, 0x62, 0xdb, 0xd8, 0x17, 0x0c, 0x8e, 0x3b,
+  0x72, 0x72, 0x1b, 0x07, 0x42, 0x64, 0x8a, 0x41, 0x7c, 0xd0, 0x0a, 0xd0, 0x5c, 0x88, 0xa3, 0xcb,
+  0xab, 0xba, 0x06, 0x19, 0x3b, 0x65, 0x73, 0xa8, 0x70, 0x2c, 0x36, 0xeb, 0xac, 0x3d, 0x6b, 0x1b,
+  0x5a, 0xef, 0x4d, 0xbf, 0xdd, 0x3b, 0x3c, 0x6a, 0xf7, 0xda, 0x80, 0x54, 0x75, 0x8d, 0x7a, 0x5c,
+  0x88, 0x58, 0xcc, 0x3a, 0x02, 0x3e, 0x2d, 0x0c, 0xa6, 0x9e, 0x3b, 0xbd, 0xa7, 0xcd, 0x02, 0x10,
+  0x55, 0x46, 0x60, 0xa3, 0x59, 0xc7, 0x90, 0xc3, 0x01, 0x50, 0x92, 0x28, 0x73, 0x1d, 0x37, 0x55,
+  0x2d, 0x1d, 0xc9, 0x72, 0x4d, 0xdf, 0xe3, 0xb0, 0x36, 0x8e, 0x18, 0xb3, 0xb7, 0x2b, 0x58, 0x3d,
+  0xa7, 0x55, 0x95, 0x94, 0x27, 0x06, 0xd2, 0x92, 0xb6, 0x20, 0x56, 0x75, 0xcd, 0x77, 0x03, 0xb3,
+  0x0e, 0xda, 0xf8, 0xd6, 0xa3, 0x59, 0xef, 0x1f, 0x1c, 0x64, 0x7a, 0xf5, 0x51, 0xc7, 0x30, 0x20,
+  0x16, 0x66, 0x3d, 0x89, 0x6c, 0xf0, 0xff, 0xfb, 0x6c, 0x61, 0x43, 0xcc, 0x5d, 0xde, 0x26, 0xd2,
+  0x66, 0x7d, 0xab, 0x20, 0x34, 0xa7, 0xc0, 0x02, 0x57, 0xfc, 0x42, 0xef, 0x23, 0x60, 0x5b, 0xd1,
+  0x7d, 0xd3, 0x04, 0x9b, 0x5d, 0x7e, 0x6e, 0x87, 0xb3, 0x74, 0x2e, 0xc5, 0xa9, 0xed, 0xd6, 0x28,
+  0x9f, 0x00, 0x0a, 0x3e, 0x52, 0xf3, 0x59, 0x8b, 0x26, 0x25, 0xa4, 0x46, 0x0c, 0xd5, 0xf5, 0x43,
+  0xe8, 0x5e, 0xb1, 0x5b, 0x31, 0xeb, 0xd4, 0x64, 0xfe, 0x89, 0x2d, 0x1b, 0x7a, 0x12, 0xe9, 0xcd,
+  0x6c, 0x32, 0x89, 0xc0, 0x96, 0x90, 0xe5, 0x16, 0x67, 0xa5, 0x49, 0x11, 0x26, 0xd3, 0x39, 0xc0,
+  0x62, 0x2c, 0xb6, 0x2d, 0xa5, 0x59, 0x16, 0xd8, 0x5b, 0xd6, 0x8e, 0xfe, 0xf6, 0x2f, 0xff, 0x51,
+  0x08, 0x8c, 0x27, 0xe5, 0x54, 0xfd, 0xe0, 0x4e, 0x49, 0x71, 0xfe, 0x09, 0x59, 0xf3, 0xe9, 0xed,
+  0xd2, 0x56, 0xe6, 0x37, 0xe4, 0x55, 0xf3, 0xa3, 0xbf, 0xfd, 0xf5, 0x1f, 0x9f, 0x2b, 0xb1, 0x6a,
+  0x4f, 0xeb, 0x79, 0x72, 0xe0, 0x08, 0xd4, 0x19, 0x4c, 0x8b, 0xf1, 0xcd, 0xc7, 0xab, 0xe7, 0x32,
+  0x4a, 0xdb, 0xcc, 0x9d, 0xba, 0x13, 0xc1, 0x13, 0xca, 0x17, 0xe6, 0xb7, 0x6b, 0x5f, 0x25, 0xd8,
+  0x50, 0x3f, 0x25, 0x00, 0x8f, 0xfd, 0xe7, 0x73, 0xc5, 0x56, 0x9d, 0xef, 0x4e, 0xa9, 0xf1, 0xfd,
+  0x09, 0xa1, 0xf3, 0xe9, 0xed, 0x32, 0x57, 0xe6, 0x37, 0x44, 0x56, 0xf3, 0x20, 0xf1, 0x7f, 0x6f,
+  0x82, 0x8f, 0x12, 0x1c, 0xc5, 0x94, 0x8d, 0x59, 0xc1, 0x4b, 0x50, 0x78, 0x63, 0x1f, 0x7d, 0x74,
+  0xcd, 0x5a, 0xf0, 0xa4, 0x59, 0x0e, 0xb4, 0x3c, 0x9a, 0x93, 0x56, 0x95, 0x9c, 0x57, 0x21, 0xe9,
+  0x4a, 0x2d, 0x3c, 0x56, 0xe1, 0x7f, 0xfa, 0x77, 0xed, 0x13, 0x67, 0x1a, 0x99, 0x44, 0x83, 0x59,
+  0x0e, 0xfc, 0xb5, 0x94, 0x4a, 0x83, 0x03, 0x91, 0xa6, 0x12, 0x1c, 0xab, 0xf3, 0x1f, 0x00, 0x6c,
+  0x35, 0x3f, 0xf1, 0x84, 0x1b, 0x79, 0x4c, 0x52, 0x23, 0x85, 0xed, 0x5a, 0xb3, 0x30, 0xb0, 0x3c,
+  0xcd, 0x87, 0xb6, 0xd2, 0x87, 0xce, 0x6b, 0x3b, 0x7c, 0xa8, 0x3f, 0x7c, 0x0a, 0xc5, 0x4c, 0x8c,
+  0x6a, 0xc0, 0x97, 0x0b, 0xed, 0xe4, 0xfa, 0xec, 0xd3, 0xe5, 0x87, 0x8f, 0x5f, 0x2e, 0xaf, 0xcc,
+  0x85, 0x1b, 0x80, 0x2d, 0xda, 0xd0, 0x82, 0x59, 0x08, 0x0b, 0xed, 0x79, 0xc8, 0x05, 0x5e, 0x4b,
+  0x7f, 0xfb, 0xa6, 0x17, 0x71, 0x5d, 0x1f, 0xd6, 0x3c, 0x38, 0xef, 0xe5, 0x08, 0x69, 0x02, 0x60,
+  0xc9, 0x31, 0x94, 0xe8, 0x4a, 0x1e, 0x3c, 0xcd, 0x55, 0x12, 0x0d, 0x1c, 0xcb, 0xe3, 0xcc, 0x40,
+  0x03, 0xab, 0x47, 0xba, 0xc1, 0x93, 0x8f, 0x14, 0x29, 0xf2, 0x79, 0x3d, 0xac, 0x39, 0x49, 0x20,
+  0x21, 0xab, 0x52, 0x17, 0x56, 0x4a, 0x4c, 0x37, 0x32, 0xed, 0x70, 0x9a, 0xa0, 0x72, 0xed, 0x19,
+  0x13, 0xe7, 0x1e, 0xe9, 0xf9, 0xf3, 0xf2, 0xd2, 0x6e, 0xe8, 0x69, 0x45, 0xd2, 0x9b, 0x12, 0x6d,
+  0xdb, 0x50, 0xad, 0xc1, 0x2f, 0xc3, 0x9a, 0xeb, 0x34, 0x7e, 0x70, 0xa3, 0xe6, 0x8a, 0x1a, 0xc3,
+  0x86, 0x7e, 0x45, 0x3e, 0xd7, 0xa8, 0x33, 0x2d, 0xf7, 0x35, 0x96, 0x2c, 0x8b, 0x7a, 0x73, 0x18,
+  0x33, 0x91, 0xc4, 0xc1, 0x70, 0xad, 0xb6, 0xe5, 0xd4, 0x5d, 0x7d, 0x8a, 0x3d, 0xf3, 0x6e, 0x2e,
+  0x44, 0x34, 0xe8, 0x74, 0x5e, 0xae, 0xdc, 0x68, 0x3d, 0x38, 0xea, 0x75, 0xe4, 0xd4, 0xdd, 0x50,
+  0x51, 0x16, 0x1b, 0xb5, 0xef, 0x89, 0x2a, 0xa9, 0x60, 0xb7, 0xd2, 0x5a, 0xd5, 0x85, 0x7d, 0x6f,
+  0xb1, 0x22, 0xa3, 0xd5, 0x05, 0x6e, 0x6d, 0xec, 0x0d, 0x33, 0x71, 0xab, 0x73, 0xd8, 0x02, 0xb7,
+  0x55, 0x93, 0x6d, 0xea, 0xd4, 0x65, 0xeb, 0x29, 0x8d, 0x62, 0x58, 0x25, 0xc2, 0xb3, 0x8f, 0x5e,
+  0xe1, 0x03, 0x43, 0x10, 0xa7, 0xb1, 0x99, 0x7a, 0x8b, 0xfc, 0xf3, 0x14, 0x93, 0xf2, 0x4e, 0xdb,
+  0xa5, 0x51, 0x1b, 0xc9, 0xf2, 0x39, 0xa6, 0xa6, 0xb9, 0xa1, 0xab, 0xce, 0x54, 0x45, 0x03, 0x06,
+  0x06, 0xe6, 0x15, 0xb3, 0x75, 0x43, 0x27, 0x11, 0x50, 0xfd, 0xf5, 0x86, 0x74, 0x5e, 0x68, 0xd9,
+  0x45, 0xe1, 0x9e, 0xe2, 0x49, 0xbc, 0x78, 0x32, 0x9d, 0x4a, 0xc7, 0x03, 0x33, 0x0c, 0x7c, 0x6f,
+  0x0c, 0x51, 0x6d, 0xcd, 0x40, 0x11, 0x26, 0x2e, 0xe1, 0x28, 0xd5, 0xd0, 0x19, 0x8f, 0xf6, 0xfa,
+  0xb0, 0x0f, 0xc4, 0x97, 0x01, 0xc1, 0x04, 0xdb, 0xd6, 0x54, 0xa2, 0x6c, 0xee, 0x97, 0x46, 0x8d,
+  0xf5, 0xc0, 0x6c, 0x48, 0xa8, 0x12, 0xc3, 0xd9, 0x16, 0x86, 0x32, 0x46, 0x15, 0x79, 0x73, 0xf5,
+  0xec, 0x08, 0x37, 0xd5, 0x12, 0x19, 0xa7, 0x94, 0x2f, 0x12, 0x24, 0x1a, 0x32, 0xa6, 0x70, 0xe4,
+  0x26, 0x6d, 0xb3, 0x1b, 0xca, 0x54, 0x24, 0xda, 0xc5, 0xf5, 0xc9, 0xfb, 0xf3, 0x2f, 0xbf, 0x9c,
+  0x5f, 0x8f, 0x2f, 0x3f, 0x7e, 0x30, 0x7b, 0xc6, 0xc5, 0xbb, 0x93, 0xdf, 0x7f, 0xb9, 0x3e, 0x1f,
+  0xff, 0xf6, 0xe1, 0x34, 0x7d, 0x3b, 0xb9, 0x7e, 0x6f, 0xee, 0x1b, 0xe3, 0xf3, 0x0f, 0x67, 0x5f,
+  0xde, 0x8f, 0x31, 0xb7, 0x8d, 0xeb, 0xf3, 0x9b, 0xeb, 0xdf, 0xe4, 0x8b, 0xcc, 0xf3, 0x05, 0x37,
+  0x83, 0xc4, 0xf3, 0x0c, 0xce, 0xbe, 0x9a, 0x5d, 0x03, 0x52, 0x67, 0x19, 0x4c, 0x4d, 0x11, 0x27,
+  0xcc, 0x00, 0x1c, 0x34, 0x55, 0xd6, 0x63, 0x23, 0x0f, 0xad, 0x88, 0xd9, 0x97, 0x8f, 0xd4, 0x85,
+  0x9b, 0xc0, 0xa0, 0xd3, 0x01, 0x88, 0xf3, 0x96, 0x9a, 0x98, 0x33, 0xea, 0x98, 0x41, 0x2a, 0x9b,
+  0x71, 0x68, 0x46, 0x6c, 0x0d, 0x8f, 0x4c, 0x4c, 0x73, 0x39, 0x00, 0x49, 0x24, 0x86, 0x9a, 0x2b,
+  0xb4, 0x59, 0xc8, 0x00, 0x11, 0xa1, 0x43, 0x43, 0x68, 0x98, 0x63, 0x7f, 0xa6, 0x59, 0xd0, 0x8f,
+  0x5b, 0x42, 0xb3, 0x90, 0x91, 0xe3, 0x3e, 0xc2, 0xb2, 0x18, 0x57, 0x35, 0x90, 0xdf, 0x14, 0x0e,
+  0x67, 0x58, 0x3c, 0xb9, 0x36, 0x59, 0xc2, 0x72, 0xce, 0x3c, 0x47, 0x73, 0x1d, 0x64, 0x04, 0x67,
+  0xb9, 0x98, 0x6b, 0x41, 0x08, 0x4d, 0x59, 0x30, 0x23, 0xd4, 0xb4, 0xb4, 0xc5, 0x1c, 0x42, 0xaa,
+  0x69, 0x20, 0xa3, 0x85, 0x2b, 0xe6, 0xc8, 0xd5, 0x07, 0xcc, 0x83, 0xbd, 0x80, 0x53, 0xe8, 0xfb,
+  0xb8, 0x93, 0x0b, 0x91, 0xe7, 0x21, 0x54, 0x0d, 0x61, 0xe3, 0xa5, 0x5c, 0x1d, 0xb0, 0x05, 0x20,
+  0x08, 0x9c, 0xab, 0xb1, 0x01, 0xe6, 0xa4, 0x48, 0x04, 0x65, 0x05, 0xa7, 0x60, 0x29, 0x59, 0x08,
+  0x9a, 0x2b, 0xb1, 0x54, 0x96, 0x70, 0x83, 0x0b, 0xe2, 0xa0, 0x5e, 0x63, 0x74, 0xca, 0x8d, 0x0b,
+  0x1e, 0x25, 0x23, 0x0e, 0x6b, 0x18, 0x6a, 0x88, 0x49, 0xe0, 0xda, 0x46, 0x94, 0xf0, 0x39, 0xc6,
+  0x2b, 0x4b, 0x1d, 0xd0, 0xdc, 0x82, 0x8d, 0xa9, 0xaf, 0x57, 0x35, 0x74, 0x04, 0x5b, 0x68, 0xbf,
+  0xb2, 0xc9, 0x18, 0x12, 0x8d, 0x89, 0xc6, 0xdd, 0x82, 0x13, 0x48, 0xe5, 0xb0, 0xbe, 0xee, 0x2c,
+  0xf8, 0x1d, 0x70, 0x59, 0xf0, 0xf6, 0xc4, 0x0d, 0x2c, 0xd8, 0x1a, 0x7b, 0x5d, 0x1d, 0x0a, 0x8e,
+  0xb5, 0x9c, 0x24, 0x8e, 0xc3, 0x62, 0x9d, 0x26, 0xc3, 0x20, 0x04, 0x25, 0xcc, 0x46, 0xd3, 0x1c,
+  0x55, 0xf3, 0x46, 0xee, 0xa7, 0x41, 0x82, 0xdf, 0x6b, 0xd0, 0x8f, 0x15, 0xd3, 0xa6, 0xe0, 0xfb,
+  0x61, 0x26, 0x7b, 0x83, 0xd2, 0x89, 0x78, 0x4e, 0xbd, 0x90, 0x33, 0xc9, 0x54, 0x05, 0xcd, 0x10,
+  0xd4, 0x45, 0xed, 0xc1, 0xa9, 0x8d, 0xb2, 0x42, 0x06, 0x9c, 0x19, 0xba, 0xf9, 0x52, 0x09, 0x35,
+  0xb4, 0x14, 0x92, 0x64, 0xc1, 0x9b, 0x30, 0x4a, 0xec, 0x24, 0xfb, 0x75, 0x6e, 0x97, 0xc2, 0xc6,
+  0xab, 0x9a, 0xb4, 0x3c, 0x09, 0x54, 0x73, 0xbc, 0x82, 0x48, 0xc5, 0x15, 0xc5, 0x89, 0x15, 0xd5,
+  0x09, 0x5a, 0xd6, 0x54, 0xf0, 0x5f, 0xa3, 0x0d, 0x5f, 0xbd, 0x82, 0x1d, 0x63, 0x3c, 0xb9, 0x13,
+  0xa5, 0x69, 0x9a, 0x99, 0x9d, 0xdb, 0x1f, 0xaf, 0xce, 0x3f, 0xc0, 0x4a, 0x88, 0x1c, 0xf2, 0x7e,
+  0xcc, 0x1e, 0x5c, 0xe8, 0x4d, 0x34, 0x27, 0x86, 0x4c, 0xc5, 0x00, 0xe6, 0xc2, 0xf5, 0x3c, 0xed,
+  0x6b, 0xc2, 0x12, 0x46, 0x31, 0x84, 0x54, 0x9c, 0x96, 0x1a, 0x1a, 0xde, 0x56, 0x58, 0x33, 0x38,
+  0x81, 0x68, 0x7c, 0x1e, 0xc6, 0xc2, 0x5b, 0xca, 0xed, 0xda, 0xd2, 0x1b, 0xcc, 0x3e, 0x81, 0x36,
+  0x27, 0x10, 0xa3, 0xae, 0x92, 0x2c, 0x8f, 0x97, 0x66, 0x21, 0x74, 0x0a, 0x56, 0x24, 0x13, 0x55,
+  0xa3, 0xaa, 0xa4, 0xfa, 0x3a, 0x4b, 0x61, 0x30, 0x43, 0xaa, 0xe3, 0x1a, 0x02, 0x2f, 0xb0, 0x2f,
+  0x50, 0xe2, 0x46, 0x69, 0x18, 0x36, 0x4d, 0x43, 0x36, 0x33, 0x08, 0x92, 0x2a, 0x37, 0x5d, 0x41,
+  0x8a, 0x54, 0xcc, 0x19, 0xc0, 0xe9, 0xf0, 0xc2, 0xb3, 0x66, 0x3c, 0xc7, 0x40, 0x07, 0x5f, 0xcd,
+  0x86, 0x8c, 0x8f, 0xb7, 0x05, 0x98, 0x19, 0x74, 0x9b, 0xdf, 0x1a, 0x00, 0x13, 0x6f, 0x53, 0xb0,
+  0x81, 0x01, 0xe4, 0xff, 0xd5, 0x6c, 0xc0, 0xc7, 0x4f, 0xbd, 0xe6, 0xab, 0xee, 0xa3, 0x83, 0x77,
+  0x70, 0x35, 0x15, 0x5b, 0x94, 0x35, 0xc3, 0x0c, 0x58, 0x86, 0x85, 0xd4, 0x4a, 0xa5, 0x96, 0xbb,
+  0x95, 0x44, 0x2a, 0xe8, 0x96, 0x8a, 0x34, 0xa1, 0x5c, 0xf9, 0x04, 0x8d, 0xd7, 0xd1, 0x09, 0x46,
+  0x7f, 0xe3, 0x08, 0x36, 0x9e, 0x7c, 0xee, 0xde, 0x9a, 0x25, 0x54, 0xc4, 0xb1, 0xde, 0xad, 0x59,
+  0xd0, 0x09, 0x47, 0xfa, 0xb7, 0x60, 0xf2, 0xaf, 0x24, 0xdb, 0x70, 0xf2, 0x79, 0x8f, 0xde, 0x46,
+  0xa3, 0x23, 0x9c, 0xda, 0xbf, 0x35, 0xf3, 0x66, 0x08, 0x07, 0x0e, 0x6e, 0xcd, 0x14, 0xfd, 0xf0,
+  0xf5, 0x50, 0xbd, 0x12, 0x02, 0x4a, 0x0e, 0x30, 0xfa, 0xfa, 0xd6, 0x9c, 0xe0, 0x77, 0x41, 0x53,
+  0xd6, 0xe8, 0x1a, 0xaf, 0x9b, 0x10, 0x68, 0x76, 0x02, 0xcf, 0x8d, 0x47, 0xe3, 0x01, 0xfc, 0xf9,
+  0xf8, 0x0f, 0x0f, 0x46, 0x57, 0x66, 0x2d, 0x6a, 0xd2, 0x98, 0x90, 0x8d, 0x02, 0x71, 0x22, 0x3e,
+  0xa3, 0x18, 0x87, 0x20, 0x40, 0xc4, 0x62, 0xbc, 0x2f, 0xc7, 0x6f, 0xdb, 0xda, 0x41, 0xb8, 0x90,
+  0x2e, 0x81, 0x80, 0xe4, 0x18, 0x82, 0x12, 0x49, 0xf1, 0x96, 0x11, 0x8f, 0xe9, 0x10, 0x6a, 0x7f,
+  0xb8, 0xb9, 0xb9, 0x92, 0x80, 0x47, 0xb1, 0x98, 0x45, 0x32, 0x06, 0x2b, 0x36, 0x68, 0x65, 0xcb,
+  0x95, 0x5c, 0x5d, 0x76, 0x69, 0xc1, 0x2e, 0x86, 0xe8, 0x6e, 0x93, 0x22, 0xc3, 0x3b, 0x99, 0x84,
+  0x11, 0x30, 0xb9, 0x00, 0x92, 0x86, 0xde, 0x51, 0xad, 0xac, 0x6e, 0xdc, 0xa1, 0xbf, 0x5f, 0xae,
+  0xe0, 0x73, 0xfd, 0x4a, 0xb2, 0x7d, 0xb9, 0xa2, 0xbf, 0xeb, 0x57, 0x62, 0x1e, 0x87, 0x42, 0x78,
+  0x0c, 0x46, 0x72, 0xab, 0xae, 0x5f, 0x81, 0xd7, 0x61, 0x24, 0x35, 0xeb, 0xfa, 0x15, 0xa7, 0x72,
+  0xa2, 0x46, 0xc8, 0xb2, 0xeb, 0xbb, 0x66, 0xad, 0x0d, 0xba, 0x05, 0x8d, 0x18, 0xf2, 0xa1, 0x06,
+  0x50, 0xcf, 0xae, 0x85, 0x68, 0x6c, 0x08, 0xd8, 0x12, 0x5d, 0x59, 0x77, 0x69, 0xc3, 0x57, 0x69,
+  0x18, 0x36, 0x4b, 0xa0, 0x17, 0xb7, 0xc3, 0xfb, 0xb7, 0xba, 0x6c, 0xec, 0xa1, 0x53, 0x18, 0xa8,
+  0x47, 0x00, 0x7d, 0x07, 0x4f, 0x28, 0xba, 0x21, 0x09, 0x52, 0x20, 0x1c, 0x14, 0xba, 0x92, 0x26,
+  0x7e, 0xa3, 0x2d, 0xa6, 0xf3, 0x06, 0x0c, 0x99, 0xa3, 0x0d, 0x28, 0x4d, 0xfb, 0x19, 0xb9, 0x20,
+  0x6b, 0x67, 0x60, 0x95, 0x03, 0xf0, 0xec, 0x79, 0x4b, 0x99, 0xcf, 0xe5, 0xa2, 0x51, 0x49, 0xe7,
+  0xd4, 0xd5, 0x1e, 0xe8, 0xae, 0x5c, 0x8d, 0x18, 0x08, 0x50, 0x33, 0x91, 0x75, 0x15, 0xea, 0xe0,
+  0x90, 0x1e, 0xe2, 0xec, 0xfa, 0x8a, 0x50, 0x89, 0xe1, 0x0b, 0x80, 0x84, 0x26, 0x42, 0x9a, 0xb6,
+  0xa6, 0xf7, 0x14, 0x32, 0xf3, 0x70, 0x81, 0xd5, 0x2b, 0x89, 0x10, 0xab, 0x2c, 0x8d, 0x07, 0x56,
+  0x04, 0x63, 0x80, 0x55, 0xbe, 0x1b, 0x00, 0xac, 0xc1, 0xb4, 0xe6, 0x85, 0x40, 0x90, 0xd6, 0xd8,
+  0x39, 0x83, 0x83, 0x88, 0x98, 0x63, 0x19, 0x06, 0x0e, 0x32, 0x3c, 0xce, 0x2e, 0xaf, 0xc7, 0xe6,
+  0x67, 0xfd, 0xe2, 0xd7, 0x33, 0xd0, 0xea, 0xfa, 0xfc, 0x17, 0xf8, 0xc4, 0xc3, 0xab, 0x7e, 0x6b,
+  0x5c, 0x8c, 0xbf, 0x8c, 0x6f, 0x4e, 0x6e, 0xce, 0x71, 0xda, 0xb5, 0x3d, 0x06, 0x33, 0xf2, 0x5b,
+  0x1f, 0x78, 0xb8, 0xb9, 0xbe, 0xbc, 0xba, 0x3a, 0x3f, 0xd3, 0x6f, 0x65, 0x67, 0x21, 0x63, 0x9c,
+  0x12, 0x55, 0xe6, 0xe8, 0xe1, 0x7e, 0x13, 0x0c, 0xe3, 0x79, 0x8d, 0x6e, 0xd3, 0x80, 0xbd, 0xc6,
+  0x0c, 0x6a, 0x54, 0xab, 0x67, 0xc4, 0x42, 0xa8, 0xea, 0x59, 0xad, 0x8e, 0x85, 0xbe, 0x27, 0x0d,
+  0x5c, 0x26, 0xab, 0xe4, 0xf9, 0x03, 0x30, 0x1f, 0x87, 0x49, 0x0c, 0x69, 0x96, 0xb7, 0xf3, 0xc5,
+  0x4a, 0xc9, 0x90, 0x82, 0xaa, 0x25, 0xc3, 0x0a, 0xe4, 0x83, 0x6b, 0xa1, 0x75, 0x33, 0x99, 0x39,
+  0x8a, 0xc1, 0x72, 0x2c, 0xce, 0x79, 0xff, 0x71, 0xfc, 0xf1, 0x43, 0x3b, 0xc2, 0x5f, 0xf2, 0x34,
+  0xa0, 0x95, 0xb5, 0x84, 0xd5, 0x4c, 0x17, 0xe5, 0x65, 0x0b, 0x21, 0x3a, 0x5b, 0xa0, 0x8b, 0x0b,
+  0x0e, 0xea, 0x06, 0x21, 0x95, 0x51, 0xdd, 0xc0, 0xdc, 0xa8, 0x80, 0xa8, 0x0a, 0x58, 0x9f, 0x83,
+  0xe0, 0x3e, 0x37, 0xdf, 0x5b, 0x62, 0xde, 0xf6, 0xad, 0x47, 0x80, 0x07, 0x18, 0x02, 0xa8, 0x03,
+  0x95, 0xf1, 0x3f, 0x93, 0x14, 0x7f, 0xeb, 0xf3, 0x01, 0xbc, 0xfd, 0xae, 0xdb, 0x3e, 0xfa, 0xc9,
+  0xe7, 0xf0, 0xa7, 0x5f, 0x81, 0xbf, 0xc2, 0xde, 0xae, 0x6d, 0xe0, 0xfd, 0x9d, 0x41, 0xe7, 0x20,
+  0x19, 0x50, 0xb9, 0x6d, 0xbc, 0x9d, 0x07, 0x0e, 0xd7, 0x46, 0x9d, 0xbc, 0x36, 0xae, 0x3d, 0x55,
+  0x3f, 0x47, 0xc2, 0x67, 0x1a, 0xa4, 0xf3, 0xec, 0x3b, 0x97, 0x8b, 0xb6, 0x08, 0x67, 0x33, 0x8f,
+  0x35, 0x74, 0xe2, 0xae, 0xcb, 0x4d, 0xca, 0x9a, 0x55, 0x8d, 0x27, 0x64, 0x65, 0x13, 0x00, 0x6d,
+  0x5f, 0x7f, 0x30, 0x4d, 0xe5, 0x56, 0x18, 0x4c, 0x1d, 0x4c, 0x33, 0x69, 0xcb, 0x8a, 0x21, 0x61,
+  0x2a, 0xec, 0xa3, 0x09, 0x44, 0x3f, 0xd9, 0x38, 0xc3, 0x60, 0x73, 0x55, 0x9d, 0x82, 0x1e, 0x73,
+  0x77, 0xee, 0x23, 0x71, 0x4b, 0xb4, 0xc1, 0xab, 0x90, 0x46, 0x54, 0x02, 0x4b, 0x3e, 0xa2, 0xdb,
+  0x67, 0x80, 0xa7, 0x97, 0x2b, 0x8c, 0x66, 0xe0, 0x09, 0xb0, 0x73, 0x0b, 0xe7, 0xdf, 0xb7, 0xfa,
+  0x5a, 0x7b, 0xb9, 0x02, 0x5d, 0xe7, 0x08, 0x33, 0xd4, 0xc3, 0xfa, 0x70, 0x98, 0x4c, 0xa8, 0x69,
+  0x45, 0x80, 0xc2, 0x5b, 0x01, 0x42, 0xd6, 0x98, 0xca, 0xbf, 0x05, 0xf9, 0x1d, 0x4c, 0x43, 0xd0,
+  0x1a, 0xf2, 0x26, 0x8c, 0x0c, 0x6d, 0x12, 0xbb, 0x36, 0xf4, 0xae, 0x57, 0xbf, 0xbe, 0xd7, 0x42,
+  0xa4, 0x5a, 0xb8, 0x9c, 0x55, 0x37, 0x97, 0x17, 0xda, 0x10, 0x1a, 0x50, 0x16, 0xbe, 0x7d, 0x83,
+  0xcf, 0x18, 0x3f, 0x1f, 0xe8, 0xf9, 0x21, 0x7e, 0x7b, 0x87, 0x02, 0x3c, 0x78, 0x6b, 0xad, 0x43,
+  0xa2, 0x3c, 0xc4, 0x6b, 0xcd, 0xf7, 0x3b, 0xfc, 0x6e, 0x40, 0x13, 0xd9, 0xb8, 0x14, 0xb0, 0xc2,
+  0x9a, 0x00, 0x92, 0xf4, 0x02, 0xb6, 0x04, 0x96, 0x5a, 0x03, 0x9f, 0xa3, 0x04, 0x8f, 0xdf, 0x09,
+  0x6f, 0x6e, 0x59, 0x73, 0x41, 0xa2, 0x20, 0x74, 0x70, 0xdc, 0x3b, 0x4b, 0x62, 0xb0, 0x8a, 0xc3,
+  0x6f, 0x15, 0x03, 0x9a, 0x5e, 0x37, 0xef, 0x06, 0x95, 0x69, 0x03, 0x3f, 0x21, 0x54, 0xfb, 0x9b,
+  0x7c, 0xc1, 0x31, 0xba, 0x51, 0x08, 0x64, 0xbd, 0xa5, 0xa3, 0x0a, 0x30, 0x02, 0xa1, 0x74, 0x81,
+  0x0d, 0x3d, 0xe4, 0x3a, 0xe8, 0xc6, 0xb7, 0xc8, 0x74, 0xea, 0xdb, 0xa4, 0x05, 0xc4, 0xce, 0xd4,
+  0xb7, 0xbf, 0x44, 0x07, 0xdd, 0x0e, 0x35, 0x8d, 0xd9, 0xca, 0xde, 0xae, 0x95, 0x78, 0xcd, 0x9e,
+  0x2e, 0x8d, 0x20, 0x74, 0xbf, 0x44, 0x6f, 0xde, 0x3c, 0x77, 0x2d, 0xde, 0xbf, 0xa3, 0x2d, 0x16,
+  0xae, 0xe3, 0x4a, 0x37, 0xc4, 0x30, 0xb2, 0xd6, 0xec, 0x9f, 0xfd, 0xbb, 0x81, 0xbc, 0x3f, 0x32,
+  0x7e, 0x90, 0xd3, 0xe5, 0xc0, 0xcf, 0x4a, 0x5f, 0x04, 0xb9, 0x6c, 0xe0, 0x17, 0x4f, 0x10, 0xe4,
+  0x69, 0xcb, 0xc2, 0xb0, 0x46, 0x6c, 0xc5, 0xa1, 0x97, 0x2b, 0xa4, 0x5f, 0xdf, 0x19, 0x80, 0x03,
+  0x4c, 0xcc, 0x43, 0x7b, 0xa0, 0x5f, 0x7d, 0x1c, 0xdf, 0xe8, 0x46, 0x4d, 0x7e, 0x23, 0xc5, 0x07,
+  0x2b, 0x5d, 0x25, 0x64, 0x0b, 0xbb, 0x79, 0x28, 0x3f, 0x56, 0x14, 0x41, 0x2b, 0x41, 0xf7, 0x36,
+  0x9d, 0xc7, 0xd6, 0x62, 0xb1, 0x68, 0x61, 0xe0, 0xb7, 0x92, 0xd8, 0x93, 0x71, 0x68, 0xeb, 0x6b,
+  0x83, 0x7e, 0xd1, 0x37, 0xc0, 0x8f, 0xda, 0xba, 0x2c, 0xe7, 0xc6, 0xd5, 0xb5, 0xbc, 0xb5, 0x86,
+  0xed, 0xf3, 0x4b, 0x1e, 0x02, 0x3b, 0x38, 0xa7, 0xa8, 0xb9, 0x61, 0x6d, 0xe7, 0x69, 0x35, 0xbf,
+  0xcb, 0x86, 0xf3, 0x6a, 0x11, 0x3c, 0x68, 0x25, 0x34, 0x04, 0x3b, 0x9a, 0xf2, 0xec, 0xca, 0xee,
+  0x9e, 0xa1, 0x9d, 0x0a, 0x97, 0x49, 0x9f, 0xe1, 0xf9, 0x56, 0xb5, 0x13, 0x52, 0xd6, 0xc2, 0x79,
+  0xb7, 0x04, 0x34, 0xd9, 0xb5, 0xde, 0x0e, 0x1e, 0xaa, 0x6d, 0x7c, 0x8a, 0x49, 0x65, 0x6e, 0xa5,
+  0x88, 0x3f, 0x5d, 0x22, 0x9d, 0x3a, 0xdb, 0x99, 0x7d, 0x04, 0x20, 0xad, 0x51, 0xe0, 0xdf, 0x4e,
+  0xa2, 0x26, 0x4d, 0x75, 0x11, 0x1f, 0x39, 0xd3, 0xaa, 0xf3, 0x18, 0x27, 0x92, 0xa2, 0xa7, 0x28,
+  0x14, 0xa3, 0xec, 0xa4, 0x6c, 0x63, 0xbf, 0x58, 0x38, 0x2c, 0x17, 0x57, 0xe3, 0xcd, 0xd9, 0xdb,
+  0x16, 0x04, 0xec, 0xa0, 0xc4, 0x94, 0x6e, 0xd1, 0xde, 0xe2, 0x30, 0x36, 0x35, 0x25, 0xcb, 0x52,
+  0x39, 0xa5, 0xbe, 0xc3, 0xac, 0xd7, 0xa5, 0xb8, 0xb8, 0xa1, 0x69, 0x76, 0x9b, 0xd9, 0x38, 0x04,
+  0xe7, 0xc2, 0x8a, 0xed, 0x7a, 0x41, 0x64, 0x49, 0xd3, 0xcb, 0x69, 0x7e, 0x06, 0x54, 0x2e, 0x12,
+  0xa5, 0xe3, 0x63, 0x38, 0x67, 0x47, 0xcc, 0xae, 0x6f, 0x5a, 0x02, 0x65, 0x4d, 0xd7, 0xff, 0x64,
+  0xd6, 0xb5, 0x77, 0xf0, 0x5e, 0xdf, 0x61, 0x15, 0x52, 0xa0, 0x48, 0x7c, 0x8d, 0x03, 0xf5, 0xca,
+  0x7d, 0x90, 0x9c, 0xde, 0xe6, 0x27, 0x74, 0xcb, 0x6a, 0x77, 0x2c, 0xd2, 0xb7, 0x16, 0x10, 0x86,
+  0x9b, 0xe5, 0x4a, 0xfd, 0x40, 0x46, 0x37, 0x2a, 0x3e, 0x7c, 0x22, 0xb0, 0xd5, 0x45, 0xf5, 0xf3,
+  0xd9, 0x91, 0xcb, 0x9f, 0x60, 0xa8, 0xbe, 0xab, 0x78, 0x3e, 0x43, 0xb2, 0xec, 0x13, 0x0c, 0xd3,
+  0x6f, 0x00, 0x9e, 0xcf, 0x51, 0xda, 0xbf, 0x92, 0x45, 0x74, 0xaf, 0xbd, 0xaa, 0x65, 0x5f, 0x43,
+  0x0c, 0x6b, 0x78, 0xfc, 0x52, 0xed, 0xfc, 0x8e, 0xec, 0xcd, 0x88, 0x4b, 0x59, 0xf7, 0x77, 0x5e,
+  0x03, 0x6f, 0xc9, 0x4b, 0xd9, 0x04, 0x00, 0xcb, 0xf7, 0x56, 0x64, 0xae, 0xf4, 0x13, 0xbc, 0x28,
+  0xff, 0x14, 0x01, 0xe4, 0xd1, 0x4d, 0x04, 0xbd, 0x9e, 0x21, 0x02, 0xa7, 0x40, 0x2c, 0x87, 0x30,
+  0xe4, 0x60, 0x88, 0xbe, 0x8d, 0x51, 0x43, 0x14, 0x58, 0x30, 0x26, 0xbf, 0xa2, 0x30, 0xf4, 0x45,
+  0xca, 0x83, 0xe7, 0x6b, 0xad, 0x7c, 0x8d, 0x9d, 0x91, 0xae, 0x0b, 0x06, 0xb7, 0x6c, 0x9b, 0xda,
+  0x48, 0x34, 0x2c, 0x83, 0x5e, 0xaf, 0xa1, 0x83, 0x64, 0x72, 0x71, 0x76, 0x0f, 0x98, 0x37, 0x57,
+  0x30, 0x67, 0x4a, 0xc9, 0x3f, 0x33, 0xfc, 0xf5, 0x8e, 0x6c, 0x5b, 0x24, 0x34, 0x31, 0xfc, 0x89,
+  0x16, 0xb2, 0x3a, 0x63, 0x8e, 0x95, 0x78, 0x22, 0xbd, 0xb0, 0xae, 0x42, 0x16, 0x90, 0x96, 0x80,
+  0x11, 0x6d, 0x42, 0x67, 0x74, 0xe2, 0x08, 0xa9, 0xaa, 0x6b, 0x7a, 0x73, 0xb5, 0x85, 0x5b, 0xee,
+  0xbd, 0x35, 0xe1, 0xfd, 0xd3, 0x3a, 0xa0, 0x25, 0xfe, 0x3e, 0x0d, 0xb6, 0x6c, 0x59, 0xc1, 0x5f,
+  0xb5, 0x71, 0x25, 0x63, 0x55, 0x4a, 0xab, 0xe6, 0xda, 0xa0, 0xaf, 0x5e, 0x75, 0x37, 0x70, 0x42,
+  0x3d, 0xbf, 0x40, 0xcd, 0x7e, 0x3a, 0xb1, 0xfb, 0x36, 0x3c, 0xa7, 0xc1, 0x53, 0x57, 0xfe, 0x56,
+  0xaa, 0x38, 0x6a, 0x13, 0x12, 0x9a, 0x36, 0x02, 0x73, 0xa9, 0x03, 0xd7, 0xaa, 0xb0, 0x44, 0xde,
+  0x48, 0xd3, 0x2f, 0x47, 0x4c, 0x5d, 0xfd, 0x74, 0x44, 0x07, 0xe9, 0x15, 0x62, 0x65, 0x4b, 0xb3,
+  0x7b, 0xaf, 0xdd, 0x8b, 0x0f, 0x7a, 0x53, 0xe7, 0xf0, 0x30, 0x5d, 0xbc, 0x93, 0x0e, 0x4e, 0xe2,
+  0x82, 0x21, 0x55, 0xf5, 0x1e, 0xe7, 0x7b, 0x0b, 0x8c, 0x3e, 0x5d, 0x92, 0xd5, 0xe8, 0x97, 0x2d,
+  0xea, 0x9b, 0x9c, 0xe3, 0x8e, 0xfa, 0x4d, 0x4b, 0x47, 0xfe, 0x1f, 0x10, 0xfe, 0x17, 0x7c, 0x18,
+  0xaf, 0x0d, 0x91, 0x30, 0x00, 0x00,
+};
+
+static const WebAsset WEB_ASSETS[] = {
+  {"/", "text/html; charset=utf-8", ASSET_INDEX_HTML, sizeof(ASSET_INDEX_HTML), "\"0a059802494394c2\""},
+};
+static const size_t WEB_ASSET_COUNT = sizeof(WEB_ASSETS) / sizeof(WEB_ASSETS[0]);
+
+#endif
@@ -1,12 +1,7 @@
 #include "WebServerManager.h"
-
-// Helper for URL decoding
-int h2int(char c) {
-    if (c >= '0' && c <='9') return c - '0';
-    if (c >= 'a' && c <='f') return c - 'a' + 10;
-    if (c >= 'A' && c <='F') return c - 'A' + 10;
-    return 0;
-}
+#include "WebAssets.h"
+#include "LogManager.h"
+#include "DriveMixer.h"
 
 WebServerManager::WebServerManager()
 : server(80) {}
@@ -15,15 +10,29 @@ WebServerManager::WebServerManager()
 void WebServerManager::init() {
     server.begin();
     _running = true;
+    initialized = true;
 }
 
 
 void WebServerManager::update(unsigned long now) {
     if (!_running) return;
 
-    WiFiClient client = server.available();
-    if (client) {
-        handleClient();
+    unsigned long startUs = micros();
+
+    // long-lived control channels first
+    for (uint8_t s = 0; s < MAX_WEBSOCKETS; ++s) {
+        pollControlChannel(s, now);
+    }
+
+    pushEvents(now);
+    acceptClient(now);
+
+    // service open requests round-robin until the pass budget is spent
+    for (uint8_t n = 0; n < MAX_CONNECTIONS; ++n) {
+        if (micros() - startUs >= UPDATE_BUDGET_US) break;
+        HttpConnection& conn = connections[nextConnection];
+        nextConnection = (nextConnection + 1) % MAX_CONNECTIONS;
+        if (conn.active) handleClient(conn, now);
     }
 }
 
@@ -32,377 +41,568 @@ bool WebServerManager::isRunning() const {
     return _running;
 }
 
+uint32_t WebServerManager::getFramesCoalesced() const {
+    return framesCoalesced;
+}
+
 /* ---------------------------------------------------
    Callback Attach
 --------------------------------------------------- */
 
-void WebServerManager::attachMotorOutputCallback(void (*cb)(uint8_t)) {
+void WebServerManager::attachMotorOutputCallback(bool (*cb)(uint8_t)) {
     motorOutputCallback = cb;
 }
 
-void WebServerManager::attachMotorDirCallback(void (*cb)(int)) {
+void WebServerManager::attachMotorDirCallback(bool (*cb)(int)) {
     motorDirCallback = cb;
 }
 
-void WebServerManager::attachServoAngleCallback(void (*cb)(int)) {
+void WebServerManager::attachServoAngleCallback(bool (*cb)(int)) {
     servoAngleCallback = cb;
 }
 
+void WebServerManager::attachDriveModeCallback(bool (*cb)(int)) {
+    driveModeCallback = cb;
+}
+
+void WebServerManager::attachTankCallback(bool (*cb)(int, int)) {
+    tankCallback = cb;
+}
+
+void WebServerManager::attachControlFrameCallback(bool (*cb)(const ControlFrame&, uint8_t)) {
+    controlFrameCallback = cb;
+}
+
+void WebServerManager::attachHeartbeatCallback(void (*cb)()) {
+    heartbeatCallback = cb;
+}
+
+void WebServerManager::attachArmCallback(bool (*cb)()) {
+    armCallback = cb;
+}
+
+void WebServerManager::attachMetricsCallback(size_t (*cb)(char*, size_t)) {
+    metricsCallback = cb;
+}
+
+void WebServerManager::attachEventCallback(size_t (*cb)(char*, size_t)) {
+    eventCallback = cb;
+}
+
+void WebServerManager::attachRecorderCallback(size_t (*cb)(Print*)) {
+    recorderCallback = cb;
+}
+
+void WebServerManager::setEventInterval(unsigned long ms) {
+    eventInterval = constrain(ms, MIN_EVENT_INTERVAL, MAX_EVENT_INTERVAL);
+}
+
+unsigned long WebServerManager::getEventInterval() const {
+    return eventInterval;
+}
+
 /* ---------------------------------------------------
    HTTP Request handlers
 --------------------------------------------------- */
 
-void WebServerManager::handleClient() {
+void WebServerManager::acceptClient(unsigned long now) {
     WiFiClient client = server.available();
+    if (!client) return;
 
-    if (client) {
-        String currentLine = "";
-        String requestLine = "";
-        String requestBody = "";
-        bool isBody = false;
-        int contentLength = 0;
-
-        while (client.connected()) {
-            if (client.available()) {
-                char c = client.read();
-
-                if (c == '\n') {
-                    if (currentLine.length() == 0) {
-                        // Empty line means headers are done
-                        isBody = true;
-
-                        // Read body if POST request
-                        if (contentLength > 0) {
-                            for (int i=0; i < contentLength && client.available(); ++i) {
-                                requestBody += (char)client.read();
-                            }
-                        }
-                        break;
-                    } else {
-                        // Process header line
-                        if (requestLine.length() == 0) {
-                            requestLine = currentLine;
-                        }
-
-                        // Check for Content-Length
-                        if (currentLine.startsWith("Content-Length: ")) {
-                            contentLength = currentLine.substring(16).toInt();
-                        }
-
-                        currentLine = "";
-                    }
-                } else if (c != '\r') {
-                    currentLine += c;
-                }
-            }
-        }
+    // available() also reports sockets we already hold that have new data
+    for (uint8_t s = 0; s < MAX_WEBSOCKETS; ++s) {
+        if (sockets[s].owns(client)) return;
+    }
+    for (uint8_t e = 0; e < MAX_EVENT_STREAMS; ++e) {
+        if (eventStreams[e].open && eventStreams[e].client == client) return;
+    }
+    HttpConnection* slot = nullptr;
+    for (uint8_t i = 0; i < MAX_CONNECTIONS; ++i) {
+        HttpConnection& conn = connections[i];
+        if (conn.active && conn.client == client) return;
+        if (!conn.active && !slot) slot = &conn;
+    }
 
-        // Parse request
-        String method = "";
-        String path = "";
+    if (!slot) {
+        sendResponse(client, 503, "text/plain", "Busy");
+        client.stop();
+        return;
+    }
 
-        int firstSpace = requestLine.indexOf(' ');
-        int secondSpace = requestLine.indexOf(' ', firstSpace + 1);
+    slot->client = client;
+    slot->request.reset();
+    slot->active = true;
+    slot->acceptedAt = now;
+    slot->lastRx = now;
+}
 
-        if (firstSpace > 0 && secondSpace > 0) {
-            method = requestLine.substring(0, firstSpace);
-            path = requestLine.substring(firstSpace+1, secondSpace);
+void WebServerManager::handleClient(HttpConnection& conn, unsigned long now) {
+    WiFiClient& client = conn.client;
+    HttpRequestParser& request = conn.request;
+
+    // peer gave up before the request was complete
+    if (!client.connected() && !client.available()) {
+        closeConnection(conn);
+        return;
+    }
+
+    // take whatever has arrived; the rest is picked up on later passes
+    uint8_t chunk[READ_CHUNK];
+    while (!request.isComplete() && !request.hasFailed() && client.available()) {
+        int n = client.read(chunk, sizeof(chunk));
+        if (n <= 0) break;
+        request.feed(chunk, n);
+        conn.lastRx = now;
+    }
+
+    if (request.hasFailed()) {
+        int code = request.errorStatus();
+        sendResponse(client, code, "text/plain", statusText(code));
+    } else if (request.isComplete()) {
+        if (handleRequest(conn, now)) {
+            // socket now belongs to a WebSocketConnection or an event stream
+            conn.client = WiFiClient();
+            conn.active = false;
+            return;
         }
+    } else if (now - conn.acceptedAt < REQUEST_DEADLINE && now - conn.lastRx < IDLE_TIMEOUT) {
+        return; // still arriving
+    } else {
+        sendResponse(client, 408, "text/plain", statusText(408));
+    }
 
-        //Route handling
-        if (method == "GET" && path == "/") {
-            sendHTMLResponse(client);
-        } else if (method == "POST" && path == "/setMotorOutput") {
-            String value = getParam(requestBody, "value");
-            if (value.length() > 0) {
-                int val = value.toInt();
-                Serial.print("<Webserver log> val: ");
-                Serial.println(val);
-                if (val < 0) val = 0;
-                if (val > 255) val = 255;
-                if (motorOutputCallback) motorOutputCallback((uint8_t)val);
-                sendResponse(client, 200, "text/plain", "OK");
-            } else {
-                sendResponse(client, 400, "text/plain", "Missing 'value'");
-            }
-        } else if (method == "POST" && path == "/setMotorDir") {
-            String dir = getParam(requestBody, "dir");
-            if (dir.length() > 0) {
-                if (motorDirCallback) motorDirCallback(dir.toInt());
-                sendResponse(client, 200, "text/plain", "OK");
-            } else {
-                sendResponse(client, 400, "text/plain", "Missing 'dir'");
-            }
-        } else if (method == "POST" && path == "/setServoAngle") {
-            String angle = getParam(requestBody, "angle");
-            if (angle.length() > 0) {
-                if (servoAngleCallback) servoAngleCallback(angle.toInt());
-                sendResponse(client, 200, "text/plain", "OK");
-            } else {
-                sendResponse(client, 400, "text/plain", "Missing 'angle'");
-            }
+    // Close connection
+    closeConnection(conn);
+}
+
+void WebServerManager::closeConnection(HttpConnection& conn) {
+    conn.client.stop();
+    conn.client = WiFiClient();
+    conn.active = false;
+}
+
+/* ---------------------------------------------------
+   Routes
+--------------------------------------------------- */
+
+// optional parameters are the exception; required ones read on one line
+#define ROUTE_PARAM(name, lo, hi) {name, lo, hi, true, false, 0}
+
+constexpr Route<WebServerManager::RouteHandler> WebServerManager::ROUTES[] = {
+    {ROUTE_GET, "/ws", &WebServerManager::routeWebSocket, {}},
+    {ROUTE_GET, "/events", &WebServerManager::routeEvents, {
+        {"interval", 0, 60000, false, false, 0}}},
+    {ROUTE_GET, "/metrics", &WebServerManager::routeMetrics, {}},
+    {ROUTE_GET, "/recorder", &WebServerManager::routeRecorder, {}},
+    {ROUTE_POST, "/control", &WebServerManager::routeControl, {
+        // the whole driver intent in one request, same rules as a ControlFrame
+        ROUTE_PARAM("seq", 0, 65535),
+        {"flags", 0, 255, false, false, 0},
+        ROUTE_PARAM("throttle", 0, 255),
+        ROUTE_PARAM("dir", 0, 2),
+        ROUTE_PARAM("steer", -100, 100)}},
+    {ROUTE_POST, "/heartbeat", &WebServerManager::routeHeartbeat, {}},
+    {ROUTE_POST, "/arm", &WebServerManager::routeArm, {}},
+    {ROUTE_POST, "/setMotorOutput", &WebServerManager::routeMotorOutput, {
+        {"value", 0, 255, true, true, 0}}},
+    {ROUTE_POST, "/setMotorDir", &WebServerManager::routeMotorDir, {
+        ROUTE_PARAM("dir", 0, 2)}},
+    {ROUTE_POST, "/setServoAngle", &WebServerManager::routeServoAngle, {
+        ROUTE_PARAM("angle", 0, 180)}},
+    {ROUTE_POST, "/setDriveMode", &WebServerManager::routeDriveMode, {
+        ROUTE_PARAM("mode", 0, DriveMixer::MODE_COUNT - 1)}},
+    {ROUTE_POST, "/setTank", &WebServerManager::routeTank, {
+        ROUTE_PARAM("left", -255, 255),
+        ROUTE_PARAM("right", -255, 255)}},
+};
+
+constexpr RouteIndex WebServerManager::ROUTE_INDEX = buildRouteIndex(WebServerManager::ROUTES);
+
+bool WebServerManager::handleRequest(HttpConnection& conn, unsigned long now) {
+    static_assert(ROUTE_INDEX.perfect, "no hash seed separates the routes, raise ROUTE_SLOT_BITS");
+
+    WiFiClient& client = conn.client;
+    const HttpRequestParser& request = conn.request;
+    RouteMethod method = routeMethod(request.method());
+    StrView path = request.path();
+
+    const Route<RouteHandler>* route = findRoute(ROUTES, ROUTE_INDEX, method, path);
+    if (!route) {
+        const WebAsset* asset = method == ROUTE_GET ? findAsset(path) : nullptr;
+        if (asset) {
+            sendAsset(client, *asset, request.header("If-None-Match"), request.header("Accept-Encoding"));
         } else {
             sendResponse(client, 404, "text/plain", "Page not found");
         }
+        return false;
+    }
 
-        // Close connection
-        client.stop();
+    long params[MAX_ROUTE_PARAMS];
+    const char* bad = nullptr;
+    ParamResult result = readRouteParams(route->params, request, params, bad);
+    if (result != PARAMS_OK) {
+        char text[48];
+        snprintf(text, sizeof(text), result == PARAM_MISSING ? "Missing '%s'" : "'%s' out of range", bad);
+        sendResponse(client, 400, "text/plain", text);
+        return false;
+    }
+    return (this->*route->handler)(client, request, params, now);
+}
+
+bool WebServerManager::routeWebSocket(WiFiClient& client, const HttpRequestParser& request, const long*, unsigned long now) {
+    StrView key = request.header("Sec-WebSocket-Key");
+    if (request.header("Upgrade").equalsIgnoreCase("websocket") && !key.empty()) {
+        return acceptWebSocket(client, key, now);
+    }
+    sendResponse(client, 400, "text/plain", "Expected WebSocket upgrade");
+    return false;
+}
+
+bool WebServerManager::routeEvents(WiFiClient& client, const HttpRequestParser&, const long* params, unsigned long now) {
+    if (!eventCallback) {
+        sendResponse(client, 404, "text/plain", "Page not found");
+        return false;
+    }
+    unsigned long interval = params[0] > 0
+        ? constrain((unsigned long)params[0], MIN_EVENT_INTERVAL, MAX_EVENT_INTERVAL) : eventInterval;
+    return acceptEventStream(client, interval, now);
+}
+
+bool WebServerManager::routeMetrics(WiFiClient& client, const HttpRequestParser&, const long*, unsigned long) {
+    if (!metricsCallback) {
+        sendResponse(client, 404, "text/plain", "Page not found");
+        return false;
+    }
+    size_t len = metricsCallback(metricsText, METRICS_SIZE);
+    sendHeaders(client, 200, "text/plain", len, "Cache-Control: no-store\r\n");
+    sendBody(client, metricsText, len);
+    return false;
+}
+
+size_t WebServerManager::printMetrics(Print& out) {
+    if (!metricsCallback) return 0;
+    size_t len = metricsCallback(metricsText, METRICS_SIZE);
+    out.write((const uint8_t*)metricsText, len);
+    return len;
+}
+
+bool WebServerManager::routeRecorder(WiFiClient& client, const HttpRequestParser&, const long*, unsigned long) {
+    if (!recorderCallback) {
+        sendResponse(client, 404, "text/plain", "Page not found");
+        return false;
+    }
+    // straight from the ring into the socket, no copy
+    sendHeaders(client, 200, "application/octet-stream", recorderCallback(nullptr),
+        "Cache-Control: no-store\r\nContent-Disposition: attachment; filename=\"recorder.bin\"\r\n");
+    recorderCallback(&client);
+    return false;
+}
+
+bool WebServerManager::routeControl(WiFiClient& client, const HttpRequestParser&, const long* params, unsigned long) {
+    ControlFrame frame;
+    frame.seq = (uint16_t)params[0];
+    frame.flags = (uint8_t)params[1];
+    frame.throttle = (uint8_t)params[2];
+    frame.direction = (uint8_t)params[3];
+    frame.steering = (int8_t)params[4];
+    if (controlFrameCallback && controlFrameCallback(frame, CONTROL_HTTP)) {
+        sendResponse(client, 200, "text/plain", "OK");
+    } else {
+        sendResponse(client, 409, "text/plain", "Stale or refused");
+    }
+    return false;
+}
+
+bool WebServerManager::routeHeartbeat(WiFiClient& client, const HttpRequestParser&, const long*, unsigned long) {
+    if (heartbeatCallback) heartbeatCallback();
+    sendResponse(client, 200, "text/plain", "OK");
+    return false;
+}
+
+bool WebServerManager::routeArm(WiFiClient& client, const HttpRequestParser&, const long*, unsigned long) {
+    if (armCallback && armCallback()) {
+        sendResponse(client, 200, "text/plain", "OK");
+    } else {
+        sendResponse(client, 409, "text/plain", "Not armed");
+    }
+    return false;
+}
+
+// 409: tripped failsafe, full command queue, or (tank) the wrong drive mode
+void WebServerManager::sendCommandResult(WiFiClient& client, bool accepted) {
+    if (accepted) {
+        sendResponse(client, 200, "text/plain", "OK");
+    } else {
+        sendResponse(client, 409, "text/plain", "Refused");
+    }
+}
+
+bool WebServerManager::routeMotorOutput(WiFiClient& client, const HttpRequestParser&, const long* params, unsigned long) {
+    LOG_DEBUG("<Webserver log> val: %ld", params[0]);
+    sendCommandResult(client, motorOutputCallback && motorOutputCallback((uint8_t)params[0]));
+    return false;
+}
+
+bool WebServerManager::routeMotorDir(WiFiClient& client, const HttpRequestParser&, const long* params, unsigned long) {
+    sendCommandResult(client, motorDirCallback && motorDirCallback(params[0]));
+    return false;
+}
+
+bool WebServerManager::routeServoAngle(WiFiClient& client, const HttpRequestParser&, const long* params, unsigned long) {
+    sendCommandResult(client, servoAngleCallback && servoAngleCallback(params[0]));
+    return false;
+}
+
+bool WebServerManager::routeDriveMode(WiFiClient& client, const HttpRequestParser&, const long* params, unsigned long) {
+    sendCommandResult(client, driveModeCallback && driveModeCallback(params[0]));
+    return false;
+}
+
+bool WebServerManager::routeTank(WiFiClient& client, const HttpRequestParser&, const long* params, unsigned long) {
+    sendCommandResult(client, tankCallback && tankCallback(params[0], params[1]));
+    return false;
+}
+
+/* ---------------------------------------------------
+   WebSocket control channel
+--------------------------------------------------- */
+
+bool WebServerManager::acceptWebSocket(WiFiClient& client, StrView key, unsigned long now) {
+    WebSocketConnection* ws = nullptr;
+    for (uint8_t s = 0; s < MAX_WEBSOCKETS && !ws; ++s) {
+        if (!sockets[s].isOpen()) ws = &sockets[s];
+    }
+    if (!ws) {
+        sendResponse(client, 503, "text/plain", "All control channels in use");
+        return false;
+    }
+
+    char accept[WebSocketConnection::ACCEPT_KEY_SIZE];
+    WebSocketConnection::acceptKey(key.data, key.len, accept);
+
+    char header[160];
+    int len = snprintf(header, sizeof(header),
+        "HTTP/1.1 101 Switching Protocols\r\n"
+        "Upgrade: websocket\r\n"
+        "Connection: Upgrade\r\n"
+        "Sec-WebSocket-Accept: %s\r\n"
+        "\r\n", accept);
+    client.write((const uint8_t*)header, len);
+
+    ws->begin(client, now);
+    LOG_INFO("<Webserver log> websocket open");
+    return true;
+}
+
+void WebServerManager::pollControlChannel(uint8_t channel, unsigned long now) {
+    // frames that queued up since the last pass collapse into the newest;
+    // flagged ones (resync, estop, arm) are applied in order, never dropped
+    WebSocketConnection& ws = sockets[channel];
+    ControlFrame latest;
+    bool haveLatest = false;
+    for (uint8_t i = 0; i < WS_MESSAGES_PER_UPDATE && ws.poll(now); ++i) {
+        ControlFrame frame;
+        if (!decodeControlMessage(ws.message(), ws.messageLength(), frame)) continue;
+
+        if (frame.flags != 0) {
+            if (haveLatest && controlFrameCallback) controlFrameCallback(latest, channel);
+            if (controlFrameCallback) controlFrameCallback(frame, channel);
+            haveLatest = false;
+            continue;
+        }
+        if (haveLatest) framesCoalesced++;
+        latest = frame;
+        haveLatest = true;
+    }
+    if (haveLatest && controlFrameCallback) controlFrameCallback(latest, channel);
+}
+
+bool WebServerManager::decodeControlMessage(const uint8_t* data, size_t len, ControlFrame& frame) {
+    // every binary message is one ControlFrame
+    if (!ControlFrame::decode(data, len, frame)) {
+        LOG_WARN("<Webserver log> bad control frame");
+        return false;
+    }
+    return true;
+}
+
+/* ---------------------------------------------------
+   Server-sent telemetry
+--------------------------------------------------- */
+
+bool WebServerManager::acceptEventStream(WiFiClient& client, unsigned long interval, unsigned long now) {
+    EventStream* stream = nullptr;
+    for (uint8_t e = 0; e < MAX_EVENT_STREAMS && !stream; ++e) {
+        if (!eventStreams[e].open) stream = &eventStreams[e];
+    }
+    if (!stream) {
+        sendResponse(client, 503, "text/plain", "All event streams in use");
+        return false;
+    }
+
+    // no Content-Length: the body runs until either side closes
+    sendHeaders(client, 200, nullptr, 0,
+        "Content-Type: text/event-stream\r\nCache-Control: no-store\r\n");
+    static const char retry[] = "retry: 1000\n\n";
+    client.write((const uint8_t*)retry, sizeof(retry) - 1);
+
+    stream->client = client;
+    stream->open = true;
+    stream->interval = interval;
+    stream->lastSent = now - interval; // first snapshot on the next pass
+    LOG_INFO("<Webserver log> event stream open, interval %lu ms", interval);
+    return true;
+}
+
+void WebServerManager::pushEvents(unsigned long now) {
+    // each stream at its own rate
+    bool due[MAX_EVENT_STREAMS];
+    bool any = false;
+    for (uint8_t e = 0; e < MAX_EVENT_STREAMS; ++e) {
+        const EventStream& stream = eventStreams[e];
+        due[e] = stream.open && now - stream.lastSent >= stream.interval;
+        any |= due[e];
+    }
+    if (!any || !eventCallback) return;
+
+    // formatted once, the same bytes go to every stream due this pass
+    size_t len = eventCallback(eventText, EVENT_SIZE);
+    for (uint8_t e = 0; e < MAX_EVENT_STREAMS; ++e) {
+        EventStream& stream = eventStreams[e];
+        if (!due[e]) continue;
+        stream.lastSent = now;
+        // a stream that can't take a whole event is gone or too slow; drop it
+        if (!stream.client.connected() || stream.client.write((const uint8_t*)eventText, len) < len) {
+            stream.client.stop();
+            stream.client = WiFiClient();
+            stream.open = false;
+            LOG_INFO("<Webserver log> event stream closed");
+        }
     }
 }
 
 // Helper methods
+const char* WebServerManager::statusText(int code) {
+    switch (code) {
+        case 200: return "OK";
+        case 304: return "Not Modified";
+        case 400: return "Bad Request";
+        case 404: return "Not Found";
+        case 408: return "Request Timeout";
+        case 409: return "Conflict";
+        case 413: return "Payload Too Large";
+        case 406: return "Not Acceptable";
+        case 414: return "URI Too Long";
+        case 431: return "Request Header Fields Too Large";
+        case 503: return "Service Unavailable";
+        default:  return "Internal Server Error";
+    }
+}
+
+void WebServerManager::sendHeaders(WiFiClient& client, int code, const char* contentType, size_t contentLength, const char* extraHeaders) {
+    // status line and headers go out in a single write
+    char header[256];
+    size_t len = 0;
+    len += snprintf(header + len, sizeof(header) - len, "HTTP/1.1 %d %s\r\n", code, statusText(code));
+    if (contentType && len < sizeof(header)) {
+        len += snprintf(header + len, sizeof(header) - len,
+            "Content-Type: %s\r\nContent-Length: %u\r\n", contentType, (unsigned)contentLength);
+    }
+    if (extraHeaders && len < sizeof(header)) {
+        len += snprintf(header + len, sizeof(header) - len, "%s", extraHeaders);
+    }
+    if (len < sizeof(header)) {
+        len += snprintf(header + len, sizeof(header) - len, "Connection: close\r\n\r\n");
+    }
+    if (len >= sizeof(header)) len = sizeof(header) - 1;
+    client.write((const uint8_t*)header, len);
+}
+
+void WebServerManager::sendBody(WiFiClient& client, const char* data, size_t len) {
+    // flash is memory mapped, so blocks are handed to the socket without copying
+    while (len > 0) {
+        size_t chunk = len < TCP_CHUNK_SIZE ? len : TCP_CHUNK_SIZE;
+        size_t written = client.write((const uint8_t*)data, chunk);
+        if (written == 0) break; // peer went away
+        data += written;
+        len -= written;
+    }
+}
+
+void WebServerManager::sendStatic(WiFiClient& client, int code, const char* contentType, const char* data, size_t len) {
+    sendHeaders(client, code, contentType, len);
+    sendBody(client, data, len);
+}
+
 void WebServerManager::sendResponse(WiFiClient& client, int code, const char* contentType, const char* content) {
-    client.print("HTTP/1.1 ");
-    client.print(code);
-    client.println(code == 200 ? " OK" : (code == 400 ? " Bad Request" : " Not Found"));
-    client.print("Content-Type: ");
-    client.println(contentType);
-    client.println("Connection: close");
-    client.println();
-    client.println(content);
-}
-
-void WebServerManager::sendHTMLResponse(WiFiClient& client) {
-    const char html[] PROGMEM = R"rawliteral(<!DOCTYPE html>
-<html lang="en">
-<head>
-<meta charset="UTF-8">
-<meta name="viewport" content="width=device-width,initial-scale=1.0">
-<title>RC Car Control</title>
-<style>
-*{margin:0;padding:0;box-sizing:border-box}
-body{font-family:Arial,sans-serif;background:linear-gradient(135deg,#667eea 0%,#764ba2 100%);min-height:100vh;padding:20px}
-.container{max-width:800px;margin:0 auto;background:#fff;border-radius:20px;box-shadow:0 20px 60px rgba(0,0,0,0.3);overflow:hidden}
-.header{background:linear-gradient(135deg,#667eea 0%,#764ba2 100%);color:#fff;padding:20px;text-align:center}
-h1{font-size:28px;margin-bottom:5px}
-.status{font-size:14px;opacity:0.9}
-.camera-section{background:#000;position:relative;padding-bottom:56.25%;overflow:hidden}
-#cameraStream{position:absolute;top:0;left:0;width:100%;height:100%;object-fit:contain}
-.camera-offline{position:absolute;top:50%;left:50%;transform:translate(-50%,-50%);color:#666;text-align:center;font-size:18px}
-.control-section{padding:30px}
-.motor-control{margin-bottom:30px}
-.slider-container{margin-top:15px}
-label{display:block;font-weight:600;margin-bottom:10px;color:#333}
-input[type="range"]{width:100%;height:8px;border-radius:5px;background:#ddd;outline:none;-webkit-appearance:none}
-input[type="range"]::-webkit-slider-thumb{-webkit-appearance:none;width:24px;height:24px;border-radius:50%;background:#667eea;cursor:pointer;box-shadow:0 2px 5px rgba(0,0,0,0.2)}
-input[type="range"]::-moz-range-thumb{width:24px;height:24px;border-radius:50%;background:#667eea;cursor:pointer;border:none;box-shadow:0 2px 5px rgba(0,0,0,0.2)}
-.slider-value{text-align:center;font-size:24px;font-weight:bold;color:#667eea;margin-top:10px}
-.direction-controls{text-align:center}
-.direction-grid{display:inline-grid;grid-template-columns:repeat(3,80px);grid-template-rows:repeat(3,80px);gap:10px;margin-top:15px}
-.arrow-btn{background:linear-gradient(145deg,#f0f0f0,#cacaca);border:none;border-radius:15px;font-size:32px;cursor:pointer;transition:all 0.1s;box-shadow:5px 5px 10px #b8b8b8,-5px -5px 10px #fff;display:flex;align-items:center;justify-content:center;user-select:none}
-.arrow-btn:hover{background:linear-gradient(145deg,#cacaca,#f0f0f0)}
-.arrow-btn.pressed{background:linear-gradient(145deg,#667eea,#764ba2);color:#fff;box-shadow:inset 3px 3px 7px #5568c4,inset -3px -3px 7px #7794ff;transform:scale(0.95)}
-.arrow-btn:active{transform:scale(0.95)}
-#upBtn{grid-column:2;grid-row:1}
-#leftBtn{grid-column:1;grid-row:2}
-#stopBtn{grid-column:2;grid-row:2;background:linear-gradient(145deg,#ff6b6b,#ee5555);color:#fff;font-size:20px;font-weight:bold}
-#rightBtn{grid-column:3;grid-row:2}
-#downBtn{grid-column:2;grid-row:3}
-.keyboard-hint{margin-top:20px;text-align:center;color:#666;font-size:14px}
-.config-section{margin-top:20px;padding:15px;background:#f5f5f5;border-radius:10px}
-.config-input{display:flex;gap:10px;margin-top:10px}
-input[type="text"]{flex:1;padding:10px;border:2px solid #ddd;border-radius:8px;font-size:14px}
-button{padding:10px 20px;background:#667eea;color:#fff;border:none;border-radius:8px;cursor:pointer;font-weight:600;transition:background 0.3s}
-button:hover{background:#5568c4}
-</style>
-</head>
-<body>
-<div class="container">
-<div class="header">
-<h1>🚗 RC Car Control</h1>
-<div class="status" id="statusText">Ready</div>
-</div>
-<div class="camera-section">
-<img id="cameraStream" src="" alt="Camera Stream">
-<div class="camera-offline" id="cameraOffline">📷 Camera Offline<br><small>Configure ESP32-CAM IP below</small></div>
-</div>
-<div class="control-section">
-<div class="config-section">
-<label>ESP32-CAM IP Address:</label>
-<div class="config-input">
-<input type="text" id="cameraIP" placeholder="e.g., 192.168.1.100" value="">
-<button onclick="connectCamera()">Connect</button>
-</div>
-</div>
-<div class="motor-control">
-<label>Motor Speed:</label>
-<div class="slider-container">
-<input type="range" id="motorSpeed" min="0" max="255" value="200" oninput="updateMotorSpeed(this.value)">
-<div class="slider-value" id="speedValue">200</div>
-</div>
-</div>
-<div class="direction-controls">
-<label>Direction Control:</label>
-<div class="direction-grid">
-<button class="arrow-btn" id="upBtn" onmousedown="pressKey('up')" onmouseup="releaseKey('up')" ontouchstart="pressKey('up')" ontouchend="releaseKey('up')">▲</button>
-<button class="arrow-btn" id="leftBtn" onmousedown="pressKey('left')" onmouseup="releaseKey('left')" ontouchstart="pressKey('left')" ontouchend="releaseKey('left')">◀</button>
-<button class="arrow-btn" id="stopBtn" onclick="stopCar()">STOP</button>
-<button class="arrow-btn" id="rightBtn" onmousedown="pressKey('right')" onmouseup="releaseKey('right')" ontouchstart="pressKey('right')" ontouchend="releaseKey('right')">▶</button>
-<button class="arrow-btn" id="downBtn" onmousedown="pressKey('down')" onmouseup="releaseKey('down')" ontouchstart="pressKey('down')" ontouchend="releaseKey('down')">▼</button>
-</div>
-<div class="keyboard-hint">💡 Use arrow keys on keyboard for control<br>Hold multiple keys for diagonal movement</div>
-</div>
-</div>
-</div>
-<script>
-const ARDUINO_IP=window.location.hostname||'192.168.1.10';
-let motorSpeed=200;
-let keysPressed={up:false,down:false,left:false,right:false};
-function connectCamera(){
-const ip=document.getElementById('cameraIP').value.trim();
-if(!ip){alert('Please enter ESP32-CAM IP address');return;}
-const streamUrl=`http://${ip}:81/stream`;
-const cameraStream=document.getElementById('cameraStream');
-const cameraOffline=document.getElementById('cameraOffline');
-cameraStream.src=streamUrl;
-cameraStream.style.display='block';
-cameraOffline.style.display='none';
-cameraStream.onerror=function(){
-cameraOffline.style.display='block';
-cameraStream.style.display='none';
-updateStatus('Camera connection failed','error');
-};
-cameraStream.onload=function(){updateStatus('Camera connected','success');};
-localStorage.setItem('esp32camIP',ip);
+    sendStatic(client, code, contentType, content, strlen(content));
 }
-window.onload=function(){
-const savedIP=localStorage.getItem('esp32camIP');
-if(savedIP){document.getElementById('cameraIP').value=savedIP;}
-};
-function updateMotorSpeed(value){
-motorSpeed=parseInt(value);
-document.getElementById('speedValue').textContent=value;
-fetch(`http://${ARDUINO_IP}/setMotorOutput`,{
-method:'POST',
-headers:{'Content-Type':'application/x-www-form-urlencoded'},
-body:`value=${motorSpeed}`
-})
-.then(response=>response.text())
-.then(data=>updateStatus('Speed updated: '+motorSpeed))
-.catch(err=>updateStatus('Connection error','error'));
-}
-function pressKey(key){
-keysPressed[key]=true;
-updateControl();
-}
-function releaseKey(key){
-keysPressed[key]=false;
-updateControl();
-}
-function updateControl(){
-updateUI();
-let dir=2;
-if (keysPressed.up) dir=0;
-else if (keysPressed.down) dir=1;
-else dir=2;
-sendMotorCommand(dir);
-let angle=105;
-if (keysPressed.left) angle=90;
-else if (keysPressed.right) angle=120;
-sendServoCommand(angle);
-let status="";
-if (dir===0) status="Forward";
-else if (dir===1) status="Backward";
-else status="Stopped";
-if (keysPressed.left) status+=" Left";
-else if (keysPressed.right) status+=" Right";
-updateStatus(status);
-}
-function updateUI(){
-document.getElementById('upBtn').classList.toggle('pressed',keysPressed.up);
-document.getElementById('downBtn').classList.toggle('pressed',keysPressed.down);
-document.getElementById('leftBtn').classList.toggle('pressed',keysPressed.left);
-document.getElementById('rightBtn').classList.toggle('pressed',keysPressed.right);
-}
-function stopCar(){
-keysPressed={up:false,down:false,left:false,right:false};
-updateControl();
-}
-function sendMotorCommand(dir){
-fetch(`http://${ARDUINO_IP}/setMotorDir`,{
-method:'POST',
-headers:{'Content-Type':'application/x-www-form-urlencoded'},
-body:`dir=${dir}`
-}).catch(err=>console.error('Motor command failed:',err));
-}
-function sendServoCommand(angle){
-fetch(`http://${ARDUINO_IP}/setServoAngle`,{
-method:'POST',
-headers:{'Content-Type':'application/x-www-form-urlencoded'},
-body:`angle=${angle}`
-}).catch(err=>console.error('Servo command failed:',err));
-}
-const keyMap={'ArrowUp':'up','ArrowDown':'down','ArrowLeft':'left','ArrowRight':'right','w':'up','s':'down','a':'left','d':'right'};
-document.addEventListener('keydown',function(e){
-const key=keyMap[e.key];
-if(key){
-e.preventDefault();
-if(!keysPressed[key]){
-pressKey(key);
-}
-}
-if(e.key===' '){e.preventDefault();stopCar();}
-});
-document.addEventListener('keyup',function(e){
-const key=keyMap[e.key];
-if(key){e.preventDefault();releaseKey(key);}
-});
-function updateStatus(message,type='info'){
-const statusText=document.getElementById('statusText');
-statusText.textContent=message;
-if(type==='error'){statusText.style.color='#ff6b6b';}
-else if(type==='success'){statusText.style.color='#51cf66';}
-else{statusText.style.color='white';}
-setTimeout(()=>{statusText.style.color='white';},2000);
-}
-</script>
-</body>
-</html>)rawliteral";
-
-    client.println("HTTP/1.1 200 OK");
-    client.println("Content-Type: text/html");
-    client.println("Connection: close");
-    client.println();
-    
-    // Send HTML in chunks to avoid buffer overflow
-    const char* ptr = html;
-    while (*ptr) {
-        client.write(*ptr++);
-    }
-}
-
-String WebServerManager::urlDecode(String str) {
-    String decoded = "";
-    char c;
-    char code0;
-    char code1;
-    for (unsigned int i = 0; i < str.length(); i++) {
-        c = str.charAt(i);
-        if (c == '+') {
-            decoded += ' ';
-        } else if (c == '%') {
-            i++;
-            code0 = str.charAt(i);
-            i++;
-            code1 = str.charAt(i);
-            c = (h2int(code0) << 4) | h2int(code1);
-            decoded += c;
-        } else {
-            decoded += c;
+
+const WebAsset* WebServerManager::findAsset(StrView path) {
+    for (size_t i = 0; i < WEB_ASSET_COUNT; ++i) {
+        if (path.equals(WEB_ASSETS[i].path)) return &WEB_ASSETS[i];
+    }
+    return nullptr;
+}
+
+// gzip, x-gzip or * in the list, not refused with q=0; no header at all
+// means any coding will do
+bool WebServerManager::acceptsGzip(StrView acceptEncoding) {
+    if (!acceptEncoding.data) return true;
+    int gzip = -1; // -1 unlisted, 0 refused, 1 accepted
+    int any = -1;
+    const char* p = acceptEncoding.data;
+    const char* end = p + acceptEncoding.len;
+    while (p < end) {
+        // one "coding;q=x" item
+        while (p < end && (*p == ' ' || *p == '\t' || *p == ',')) ++p;
+        StrView coding;
+        coding.data = p;
+        while (p < end && *p != ';' && *p != ',' && *p != ' ' && *p != '\t') ++p;
+        coding.len = p - coding.data;
+        bool zero = false;
+        while (p < end && *p != ',') {
+            if (*p == ';') {
+                ++p;
+                while (p < end && *p == ' ') ++p;
+                if (end - p >= 2 && (p[0] == 'q' || p[0] == 'Q') && p[1] == '=') {
+                    p += 2;
+                    zero = p < end && *p == '0';
+                    if (zero && ++p < end && *p == '.') {
+                        while (++p < end && *p >= '0' && *p <= '9') zero &= *p == '0';
+                    }
+                    continue;
+                }
+            }
+            ++p;
         }
+        if (coding.equalsIgnoreCase("gzip") || coding.equalsIgnoreCase("x-gzip")) gzip = zero ? 0 : 1;
+        else if (coding.equals("*")) any = zero ? 0 : 1;
     }
-    return decoded;
+    if (gzip >= 0) return gzip == 1;
+    return any == 1;
 }
 
+void WebServerManager::sendAsset(WiFiClient& client, const WebAsset& asset, StrView ifNoneMatch, StrView acceptEncoding) {
+    // caches must key the gzipped body on what the request accepted
+    char extra[128];
+    snprintf(extra, sizeof(extra), "ETag: %s\r\nCache-Control: no-cache\r\nVary: Accept-Encoding\r\n", asset.etag);
 
-String WebServerManager::getParam(String data, String param) {
-    String searchStr = param + "=";
-    int start = data.indexOf(searchStr);
-    if (start == -1) return "";
-    
-    start += searchStr.length();
-    int end = data.indexOf('&', start);
-    if (end == -1) end = data.length();
-    
-    return urlDecode(data.substring(start, end));
-}
\ No newline at end of file
+    if (!acceptsGzip(acceptEncoding)) {
+        static const char text[] = "Only served gzip-encoded";
+        sendHeaders(client, 406, "text/plain", sizeof(text) - 1, "Vary: Accept-Encoding\r\n");
+        sendBody(client, text, sizeof(text) - 1);
+        return;
+    }
+
+    // browser already holds this build of the asset
+    if (ifNoneMatch.contains(asset.etag)) {
+        sendHeaders(client, 304, nullptr, 0, extra);
+        return;
+    }
+
+    size_t n = strlen(extra);
+    snprintf(extra + n, sizeof(extra) - n, "Content-Encoding: gzip\r\n");
+    sendHeaders(client, 200, asset.contentType, asset.len, extra);
+    sendBody(client, (const char*)asset.data, asset.len);
+}
@@ -2,36 +2,156 @@
 #define WEBSERVER_MANAGER_H
 
 #include <WiFiS3.h>
+#include "BasicManager.h"
+#include "WebSocketConnection.h"
+#include "ControlFrame.h"
+#include "HttpRequestParser.h"
+#include "RouteTable.h"
 
-class WebServerManager {
+struct WebAsset;
+
+class WebServerManager : public BasicManager {
 public:
     WebServerManager();
 
-    void init();
-    void update(unsigned long now);
+    void init() override;
+    void update(unsigned long now) override;
+
+    // control channels: one per WebSocket, then POST /control
+    static const uint8_t MAX_WEBSOCKETS = 2;
+    static const uint8_t CONTROL_HTTP = MAX_WEBSOCKETS;
+    static const uint8_t CONTROL_CHANNELS = MAX_WEBSOCKETS + 1;
 
     bool isRunning() const;
+    // WebSocket control frames superseded within a pass and never applied
+    uint32_t getFramesCoalesced() const;
 
     // ----- API 등록용 -----
-    void attachMotorOutputCallback(void (*cb)(uint8_t));
-    void attachMotorDirCallback(void (*cb)(int));
-    void attachServoAngleCallback(void (*cb)(int));
+    // each returns false when the command was refused (answered 409)
+    void attachMotorOutputCallback(bool (*cb)(uint8_t));
+    void attachMotorDirCallback(bool (*cb)(int));
+    void attachServoAngleCallback(bool (*cb)(int));
+    void attachDriveModeCallback(bool (*cb)(int));
+    void attachTankCallback(bool (*cb)(int, int));
+    // false when the frame was stale or refused; channel is where it came
+    // from, each numbering its frames on its own
+    void attachControlFrameCallback(bool (*cb)(const ControlFrame&, uint8_t channel));
+    void attachHeartbeatCallback(void (*cb)());
+    void attachArmCallback(bool (*cb)());
+    // fills GET /metrics, returns the text length
+    void attachMetricsCallback(size_t (*cb)(char* out, size_t size));
+    // fills one telemetry event for GET /events, returns the text length
+    void attachEventCallback(size_t (*cb)(char* out, size_t size));
+    // writes GET /recorder to out, or returns its size when out is null
+    void attachRecorderCallback(size_t (*cb)(Print* out));
+
+    // the GET /metrics text written to out (the serial console), formatted
+    // in the same buffer; returns its length
+    size_t printMetrics(Print& out);
+
+    // how often /events streams a snapshot; GET /events?interval=ms picks
+    // another rate for that stream only
+    void setEventInterval(unsigned long ms);
+    unsigned long getEventInterval() const;
 
 private:
     WiFiServer server;
     bool _running = false;
 
+    // operator control channels on GET /ws
+    static const uint8_t WS_MESSAGES_PER_UPDATE = 8;
+    WebSocketConnection sockets[MAX_WEBSOCKETS];
+    uint32_t framesCoalesced = 0;
+
+    // telemetry streams on GET /events, all fed from one formatted snapshot
+    struct EventStream {
+        WiFiClient client;
+        bool open = false;
+        unsigned long interval = 0; // ms
+        unsigned long lastSent = 0;
+    };
+    static const uint8_t MAX_EVENT_STREAMS = 2;
+    static const size_t EVENT_SIZE = 512;
+    static const unsigned long MIN_EVENT_INTERVAL = 50;  // ms
+    static const unsigned long MAX_EVENT_INTERVAL = 5000; // ms
+    EventStream eventStreams[MAX_EVENT_STREAMS];
+    unsigned long eventInterval = 200; // for streams that didn't ask
+    char eventText[EVENT_SIZE];
+
+    // requests being received, each parsed across update() calls
+    struct HttpConnection {
+        WiFiClient client;
+        HttpRequestParser request;
+        bool active = false;
+        unsigned long acceptedAt = 0;
+        unsigned long lastRx = 0;
+    };
+    static const uint8_t MAX_CONNECTIONS = 3;
+    static const size_t READ_CHUNK = 128;
+    static const unsigned long REQUEST_DEADLINE = 3000; // whole request, ms
+    static const unsigned long IDLE_TIMEOUT = 1000;     // between bytes, ms
+    static const unsigned long UPDATE_BUDGET_US = 4000; // HTTP work per pass
+    HttpConnection connections[MAX_CONNECTIONS];
+    uint8_t nextConnection = 0;
+
     // callback functions
-    void (*motorOutputCallback)(uint8_t) = nullptr;
-    void (*motorDirCallback)(int) = nullptr;
-    void (*servoAngleCallback)(int) = nullptr;
+    bool (*motorOutputCallback)(uint8_t) = nullptr;
+    bool (*motorDirCallback)(int) = nullptr;
+    bool (*servoAngleCallback)(int) = nullptr;
+    bool (*driveModeCallback)(int) = nullptr;
+    bool (*tankCallback)(int, int) = nullptr;
+    bool (*controlFrameCallback)(const ControlFrame&, uint8_t) = nullptr;
+    void (*heartbeatCallback)() = nullptr;
+    bool (*armCallback)() = nullptr;
+    size_t (*metricsCallback)(char*, size_t) = nullptr;
+    size_t (*eventCallback)(char*, size_t) = nullptr;
+    size_t (*recorderCallback)(Print*) = nullptr;
+
+    static const size_t METRICS_SIZE = 1536;
+    char metricsText[METRICS_SIZE];
 
     // API handlers
-    void handleClient();
+    void acceptClient(unsigned long now);
+    void handleClient(HttpConnection& conn, unsigned long now);
+    void closeConnection(HttpConnection& conn);
+    bool handleRequest(HttpConnection& conn, unsigned long now);
+    bool acceptWebSocket(WiFiClient& client, StrView key, unsigned long now);
+    void pollControlChannel(uint8_t channel, unsigned long now);
+    bool decodeControlMessage(const uint8_t* data, size_t len, ControlFrame& frame);
+    bool acceptEventStream(WiFiClient& client, unsigned long interval, unsigned long now);
+    void pushEvents(unsigned long now);
     void sendResponse(WiFiClient& client, int code, const char* contentType, const char* content);
-    void sendHTMLResponse(WiFiClient& client);
-    String urlDecode(String str);
-    String getParam(String data, String param);
+    void sendCommandResult(WiFiClient& client, bool accepted);
+
+    // route table (RouteTable.h); handlers get the validated parameters in
+    // schema order and return true when they keep the connection
+    typedef bool (WebServerManager::*RouteHandler)(WiFiClient&, const HttpRequestParser&, const long* params, unsigned long now);
+    static const Route<RouteHandler> ROUTES[];
+    static const RouteIndex ROUTE_INDEX;
+    bool routeWebSocket(WiFiClient& client, const HttpRequestParser& request, const long* params, unsigned long now);
+    bool routeEvents(WiFiClient& client, const HttpRequestParser& request, const long* params, unsigned long now);
+    bool routeMetrics(WiFiClient& client, const HttpRequestParser& request, const long* params, unsigned long now);
+    bool routeRecorder(WiFiClient& client, const HttpRequestParser& request, const long* params, unsigned long now);
+    bool routeControl(WiFiClient& client, const HttpRequestParser& request, const long* params, unsigned long now);
+    bool routeHeartbeat(WiFiClient& client, const HttpRequestParser& request, const long* params, unsigned long now);
+    bool routeArm(WiFiClient& client, const HttpRequestParser& request, const long* params, unsigned long now);
+    bool routeMotorOutput(WiFiClient& client, const HttpRequestParser& request, const long* params, unsigned long now);
+    bool routeMotorDir(WiFiClient& client, const HttpRequestParser& request, const long* params, unsigned long now);
+    bool routeServoAngle(WiFiClient& client, const HttpRequestParser& request, const long* params, unsigned long now);
+    bool routeDriveMode(WiFiClient& client, const HttpRequestParser& request, const long* params, unsigned long now);
+    bool routeTank(WiFiClient& client, const HttpRequestParser& request, const long* params, unsigned long now);
+
+    // streaming response writer
+    static const size_t TCP_CHUNK_SIZE = 1460; // one TCP segment (MSS)
+    static const char* statusText(int code);
+    void sendHeaders(WiFiClient& client, int code, const char* contentType, size_t contentLength, const char* extraHeaders = nullptr);
+    void sendBody(WiFiClient& client, const char* data, size_t len);
+    void sendStatic(WiFiClient& client, int code, const char* contentType, const char* data, size_t len);
+
+    // gzipped UI assets (WebAssets.h), there is no other copy of them
+    const WebAsset* findAsset(StrView path);
+    static bool acceptsGzip(StrView acceptEncoding);
+    void sendAsset(WiFiClient& client, const WebAsset& asset, StrView ifNoneMatch, StrView acceptEncoding);
 };
 
 #endif
@@ -0,0 +1,176 @@
+#include "WebSocketConnection.h"
+#include "Sha1.h"
+
+static const char WS_GUID[] = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+static const char BASE64[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+void WebSocketConnection::acceptKey(const char* clientKey, size_t keyLen, char out[ACCEPT_KEY_SIZE]) {
+  uint8_t digest[Sha1::DIGEST_SIZE];
+  Sha1 sha;
+  sha.update((const uint8_t*)clientKey, keyLen);
+  sha.update((const uint8_t*)WS_GUID, sizeof(WS_GUID) - 1);
+  sha.finish(digest);
+
+  // base64 of 20 bytes: six full groups plus one padded group
+  size_t o = 0;
+  for (size_t i = 0; i < Sha1::DIGEST_SIZE; i += 3) {
+    uint32_t v = (uint32_t)digest[i] << 16;
+    if (i + 1 < Sha1::DIGEST_SIZE) v |= (uint32_t)digest[i + 1] << 8;
+    if (i + 2 < Sha1::DIGEST_SIZE) v |= digest[i + 2];
+    out[o++] = BASE64[(v >> 18) & 0x3F];
+    out[o++] = BASE64[(v >> 12) & 0x3F];
+    out[o++] = (i + 1 < Sha1::DIGEST_SIZE) ? BASE64[(v >> 6) & 0x3F] : '=';
+    out[o++] = (i + 2 < Sha1::DIGEST_SIZE) ? BASE64[v & 0x3F] : '=';
+  }
+  out[o] = '\0';
+}
+
+void WebSocketConnection::begin(const WiFiClient& newClient, unsigned long now) {
+  if (open) close(1001); // a newer operator takes over
+  client = newClient;
+  open = true;
+  lastRx = now;
+  lastPing = now;
+  resetFrame();
+}
+
+void WebSocketConnection::close(uint16_t code) {
+  if (!open) return;
+  uint8_t reason[2] = {(uint8_t)(code >> 8), (uint8_t)code};
+  send(OP_CLOSE, reason, sizeof(reason));
+  client.stop();
+  open = false;
+  resetFrame();
+}
+
+bool WebSocketConnection::poll(unsigned long now) {
+  if (!open) return false;
+  if (messageReady) resetFrame();
+
+  if (!client.connected()) {
+    client.stop();
+    open = false;
+    return false;
+  }
+
+  while (open && client.available()) {
+    int c = client.read();
+    if (c < 0) break;
+    lastRx = now;
+
+    if (headerLen < headerNeeded) {
+      header[headerLen++] = (uint8_t)c;
+      if (headerLen == 2) {
+        if (!parseHeader()) return false;
+      } else if (headerLen == headerNeeded) {
+        uint8_t len7 = header[1] & 0x7F;
+        payloadLen = (len7 == 126) ? (((size_t)header[2] << 8) | header[3]) : len7;
+        if (payloadLen > MAX_PAYLOAD) {
+          close(1009); // message too big
+          return false;
+        }
+        if (payloadLen == 0 && handleFrame()) return true;
+      }
+      continue;
+    }
+
+    const uint8_t* mask = &header[headerNeeded - 4];
+    payload[payloadPos] = (uint8_t)c ^ mask[payloadPos & 3];
+    payloadPos++;
+    if (payloadPos == payloadLen && handleFrame()) return true;
+  }
+
+  if (!open) return false;
+
+  // keep the link alive and notice peers that vanished without a close
+  if (now - lastRx >= IDLE_TIMEOUT) {
+    close(1001);
+  } else if (now - lastRx >= PING_INTERVAL && now - lastPing >= PING_INTERVAL) {
+    send(OP_PING, nullptr, 0);
+    lastPing = now;
+  }
+  return false;
+}
+
+const uint8_t* WebSocketConnection::message() const {
+  return payload;
+}
+
+size_t WebSocketConnection::messageLength() const {
+  return messageReady ? payloadLen : 0;
+}
+
+bool WebSocketConnection::send(WebSocketConnection::Opcode op, const uint8_t* data, size_t len) {
+  if (!open || len > MAX_PAYLOAD) return false;
+
+  // server frames are unmasked; one write per frame
+  uint8_t frame[2 + MAX_PAYLOAD];
+  frame[0] = 0x80 | op; // FIN
+  frame[1] = (uint8_t)len;
+  if (len > 0) memcpy(frame + 2, data, len);
+  return client.write(frame, len + 2) == len + 2;
+}
+
+bool WebSocketConnection::isOpen() const {
+  return open;
+}
+
+bool WebSocketConnection::owns(WiFiClient& other) {
+  return open && client == other;
+}
+
+void WebSocketConnection::resetFrame() {
+  headerLen = 0;
+  headerNeeded = 2;
+  payloadLen = 0;
+  payloadPos = 0;
+  messageReady = false;
+}
+
+bool WebSocketConnection::parseHeader() {
+  bool fin = header[0] & 0x80;
+  uint8_t op = header[0] & 0x0F;
+  bool masked = header[1] & 0x80;
+  uint8_t len7 = header[1] & 0x7F;
+
+  if (!masked) {
+    close(1002); // clients must mask every frame
+    return false;
+  }
+  if (len7 == 127) {
+    close(1009);
+    return false;
+  }
+  if (!fin || op == OP_CONTINUATION) {
+    close(1003); // fragmented messages are not supported
+    return false;
+  }
+
+  headerNeeded = 2 + (len7 == 126 ? 2 : 0) + 4;
+  return true;
+}
+
+bool WebSocketConnection::handleFrame() {
+  switch (header[0] & 0x0F) {
+    case OP_BINARY:
+      messageReady = true;
+      return true;
+
+    case OP_PING:
+      send(OP_PONG, payload, payloadLen);
+      break;
+
+    case OP_CLOSE:
+      // echo the peer's status code and drop the socket
+      send(OP_CLOSE, payload, payloadLen >= 2 ? 2 : 0);
+      client.stop();
+      open = false;
+      break;
+
+    default:
+      // text and pong frames carry nothing we act on
+      break;
+  }
+  resetFrame();
+  return false;
+}
@@ -0,0 +1,62 @@
+#ifndef WEBSOCKET_CONNECTION_H
+#define WEBSOCKET_CONNECTION_H
+
+#include <Arduino.h>
+#include <WiFiS3.h>
+
+// Server side of one RFC 6455 WebSocket, read without blocking
+class WebSocketConnection {
+  public:
+    enum Opcode {
+      OP_CONTINUATION = 0x0,
+      OP_TEXT = 0x1,
+      OP_BINARY = 0x2,
+      OP_CLOSE = 0x8,
+      OP_PING = 0x9,
+      OP_PONG = 0xA
+    };
+
+    static const size_t MAX_PAYLOAD = 125;
+    static const size_t ACCEPT_KEY_SIZE = 29; // base64(sha1) + '\0'
+
+    // Sec-WebSocket-Accept value for a Sec-WebSocket-Key
+    static void acceptKey(const char* clientKey, size_t keyLen, char out[ACCEPT_KEY_SIZE]);
+
+    void begin(const WiFiClient& client, unsigned long now);
+    void close(uint16_t code = 1000);
+
+    // reads what the socket has; true when a binary message is ready
+    bool poll(unsigned long now);
+    const uint8_t* message() const;
+    size_t messageLength() const;
+
+    bool send(Opcode op, const uint8_t* data, size_t len);
+
+    bool isOpen() const;
+    bool owns(WiFiClient& other);
+
+  private:
+    static const unsigned long PING_INTERVAL = 5000;
+    static const unsigned long IDLE_TIMEOUT = 15000;
+
+    WiFiClient client;
+    bool open = false;
+
+    // frame being assembled
+    uint8_t header[8];         // 2 fixed + up to 2 length + 4 mask
+    uint8_t headerLen = 0;
+    uint8_t headerNeeded = 2;
+    uint8_t payload[MAX_PAYLOAD];
+    size_t payloadLen = 0;
+    size_t payloadPos = 0;
+    bool messageReady = false;
+
+    unsigned long lastRx = 0;
+    unsigned long lastPing = 0;
+
+    void resetFrame();
+    bool parseHeader();
+    bool handleFrame();
+};
+
+#endif
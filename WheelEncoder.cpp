@@ -0,0 +1,79 @@
+#include "WheelEncoder.h"
+
+void WheelEncoder::begin(uint8_t pin, void (*isr)()) {
+  pinMode(pin, INPUT_PULLUP);
+  attachInterrupt(digitalPinToInterrupt(pin), isr, RISING);
+}
+
+void WheelEncoder::setConfig(const Config& c) {
+  cfg = c;
+}
+
+const WheelEncoder::Config& WheelEncoder::getConfig() const {
+  return cfg;
+}
+
+void WheelEncoder::onEdge(uint32_t nowUs) {
+  // unsigned difference, so a micros() wrap in between still measures right
+  uint32_t period = nowUs - lastEdgeUs;
+  if (count != 0 && period < cfg.minPeriodUs) {
+    glitches++;
+    return;
+  }
+  lastPeriodUs = period;
+  lastEdgeUs = nowUs;
+  count++;
+}
+
+uint16_t WheelEncoder::sample(uint32_t nowUs) {
+  noInterrupts();
+  uint32_t c = count;
+  uint32_t edgeUs = lastEdgeUs;
+  uint32_t periodUs = lastPeriodUs;
+  interrupts();
+
+  uint32_t edges = c - sampledCount;
+  uint32_t stallUs = (uint32_t)cfg.stallMs * 1000;
+
+  if (edges > 0) {
+    uint32_t span = edgeUs - sampledEdgeUs;
+    if (sampledCount != 0 && span <= stallUs) {
+      speed = mmPerSec(edges, span);
+    } else if (edges > 1 && periodUs <= stallUs) {
+      // first edges after standing still: only the latest gap means anything
+      speed = mmPerSec(1, periodUs);
+    } else {
+      speed = 0;
+    }
+    sampledCount = c;
+    sampledEdgeUs = edgeUs;
+  } else {
+    // no new edge: the wheel is at most as fast as one edge in that time
+    uint32_t since = nowUs - sampledEdgeUs;
+    if (since > stallUs) {
+      speed = 0;
+    } else {
+      uint16_t bound = mmPerSec(1, since);
+      if (bound < speed) speed = bound;
+    }
+  }
+  return speed;
+}
+
+uint16_t WheelEncoder::getSpeed() const {
+  return speed;
+}
+
+uint32_t WheelEncoder::getCount() const {
+  return count;
+}
+
+uint32_t WheelEncoder::getGlitches() const {
+  return glitches;
+}
+
+uint16_t WheelEncoder::mmPerSec(uint32_t edges, uint32_t spanUs) const {
+  if (spanUs == 0 || cfg.countsPerRev == 0) return 0;
+  uint64_t v = (uint64_t)edges * cfg.circumferenceMm * 1000000UL / ((uint64_t)cfg.countsPerRev * spanUs);
+  return v > 0xFFFF ? 0xFFFF : (uint16_t)v;
+}
@@ -0,0 +1,48 @@
+#ifndef WHEEL_ENCODER_H
+#define WHEEL_ENCODER_H
+
+#include <Arduino.h>
+
+// Pulse counter for one wheel, fed from a pin interrupt. Speed is taken over
+// the span between the first and last edge since the previous sample, so it
+// stays exact with only a few edges per sample, and decays toward zero when
+// edges stop coming. Single channel: the caller supplies the sign.
+class WheelEncoder {
+  public:
+    struct Config {
+      uint16_t countsPerRev = 20;
+      uint16_t circumferenceMm = 204; // 65 mm wheel
+      uint16_t minPeriodUs = 200;     // edges closer than this are noise
+      uint16_t stallMs = 250;         // no edge for this long reads as stopped
+    };
+
+    void begin(uint8_t pin, void (*isr)());
+    void setConfig(const Config& c);
+    const Config& getConfig() const;
+
+    // from the pin interrupt
+    void onEdge(uint32_t nowUs);
+
+    // speed in mm/s (magnitude), call at a steady rate
+    uint16_t sample(uint32_t nowUs);
+    uint16_t getSpeed() const;
+    uint32_t getCount() const;
+    uint32_t getGlitches() const;
+
+  private:
+    Config cfg;
+
+    // written by the ISR
+    volatile uint32_t count = 0;
+    volatile uint32_t lastEdgeUs = 0;
+    volatile uint32_t lastPeriodUs = 0;
+    volatile uint32_t glitches = 0;
+
+    uint32_t sampledCount = 0;
+    uint32_t sampledEdgeUs = 0;
+    uint16_t speed = 0;
+
+    uint16_t mmPerSec(uint32_t edges, uint32_t spanUs) const;
+};
+
+#endif
@@ -0,0 +1,51 @@
+#ifndef HOST_ADAFRUIT_GFX_H
+#define HOST_ADAFRUIT_GFX_H
+
+#include <Arduino.h>
+
+#define BLACK 0
+#define WHITE 1
+
+// text-mode stand-in: keeps the characters drawn in a 6x8 cell grid and
+// stamps a placeholder glyph into the pixels so the framebuffer changes too
+class Adafruit_GFX : public Print {
+  public:
+    static const uint8_t CELL_W = 6;
+    static const uint8_t CELL_H = 8;
+    static const uint8_t MAX_COLS = 32;
+    static const uint8_t MAX_ROWS = 8;
+
+    Adafruit_GFX(int16_t w, int16_t h);
+
+    virtual void drawPixel(int16_t x, int16_t y, uint16_t color) = 0;
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+    void fillScreen(uint16_t color) { fillRect(0, 0, _width, _height, color); }
+
+    void setCursor(int16_t x, int16_t y) { cursorX = x; cursorY = y; }
+    void setTextSize(uint8_t) {}
+    void setTextColor(uint16_t c) { textColor = c; }
+    void setTextColor(uint16_t c, uint16_t) { textColor = c; }
+    void setTextWrap(bool w) { wrap = w; }
+
+    size_t write(uint8_t c) override;
+    using Print::write;
+
+    int16_t width() const { return _width; }
+    int16_t height() const { return _height; }
+
+    // characters currently drawn on text row `row`, trailing blanks trimmed
+    String textRow(uint8_t row) const;
+
+  protected:
+    int16_t _width;
+    int16_t _height;
+
+  private:
+    int16_t cursorX = 0;
+    int16_t cursorY = 0;
+    uint16_t textColor = WHITE;
+    bool wrap = true;
+    char cells[MAX_ROWS][MAX_COLS];
+};
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef HOST_ADAFRUIT_SSD1306_H
+#define HOST_ADAFRUIT_SSD1306_H
+
+#include <Adafruit_GFX.h>
+#include <Wire.h>
+
+#define SSD1306_SWITCHCAPVCC 0x02
+#define SSD1306_COLUMNADDR   0x21
+#define SSD1306_PAGEADDR     0x22
+
+// framebuffer in the same page layout as the driver; data sent over Wire
+// lands in a model of the panel's GDDRAM, see host::panelMatchesBuffer()
+class Adafruit_SSD1306 : public Adafruit_GFX {
+  public:
+    Adafruit_SSD1306(uint8_t w, uint8_t h, TwoWire* twi, int8_t rstPin,
+                     uint32_t clkDuring = 400000UL, uint32_t clkAfter = 100000UL);
+    ~Adafruit_SSD1306();
+
+    bool begin(uint8_t vccstate, uint8_t i2caddr);
+    void clearDisplay();
+    void display();
+    void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+    void ssd1306_command(uint8_t c);
+    uint8_t* getBuffer() { return buffer; }
+
+  private:
+    uint8_t* buffer;
+};
+
+#endif
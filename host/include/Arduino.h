@@ -0,0 +1,193 @@
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+// Linux backend for the part of the Arduino core API the sketch uses
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <string>
+
+// sketch code can tell the host backend from a board core
+#define ARDUINO_ARCH_HOST
+
+#define PROGMEM
+#define F(s) (s)
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT        0x0
+#define OUTPUT       0x1
+#define INPUT_PULLUP 0x2
+
+#define CHANGE  1
+#define FALLING 2
+#define RISING  3
+
+// analog header pins, numbered after D13 like the UNO R4
+#define A0 14
+#define A1 15
+#define A2 16
+#define A3 17
+#define A4 18
+#define A5 19
+
+#define DEC 10
+#define HEX 16
+#define BIN 2
+
+#define digitalPinToInterrupt(p) (p)
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+template <class T, class L>
+auto min(const T& a, const L& b) -> decltype(b < a ? b : a) { return (b < a) ? b : a; }
+template <class T, class L>
+auto max(const T& a, const L& b) -> decltype(b < a ? b : a) { return (a < b) ? b : a; }
+
+/* ---------------------------------------------------
+   String
+--------------------------------------------------- */
+
+class String {
+  public:
+    String(const char* s = "") : str(s ? s : "") {}
+    String(const std::string& s) : str(s) {}
+    explicit String(char c) : str(1, c) {}
+    explicit String(int v) : str(std::to_string(v)) {}
+    explicit String(unsigned int v) : str(std::to_string(v)) {}
+    explicit String(long v) : str(std::to_string(v)) {}
+    explicit String(unsigned long v) : str(std::to_string(v)) {}
+
+    unsigned int length() const { return str.size(); }
+    const char* c_str() const { return str.c_str(); }
+    void reserve(unsigned int n) { str.reserve(n); }
+
+    char charAt(unsigned int i) const { return i < str.size() ? str[i] : 0; }
+    char operator[](unsigned int i) const { return charAt(i); }
+
+    int indexOf(char c, unsigned int from = 0) const { return find(str.find(c, from)); }
+    int indexOf(const String& s, unsigned int from = 0) const { return find(str.find(s.str, from)); }
+    String substring(unsigned int from) const { return from < str.size() ? String(str.substr(from)) : String(); }
+    String substring(unsigned int from, unsigned int to) const {
+      return from < to && from < str.size() ? String(str.substr(from, to - from)) : String();
+    }
+    bool startsWith(const String& s) const { return str.compare(0, s.str.size(), s.str) == 0; }
+    long toInt() const { return atol(str.c_str()); }
+    void toLowerCase() { for (auto& c : str) c = (c >= 'A' && c <= 'Z') ? c + 32 : c; }
+    void trim() {
+      size_t a = str.find_first_not_of(" \t\r\n");
+      size_t b = str.find_last_not_of(" \t\r\n");
+      str = (a == std::string::npos) ? "" : str.substr(a, b - a + 1);
+    }
+
+    String& operator+=(const String& s) { str += s.str; return *this; }
+    String& operator+=(const char* s) { str += s; return *this; }
+    String& operator+=(char c) { str += c; return *this; }
+    friend String operator+(const String& a, const String& b) { return String(a.str + b.str); }
+
+    bool operator==(const String& s) const { return str == s.str; }
+    bool operator==(const char* s) const { return str == s; }
+    bool operator!=(const String& s) const { return str != s.str; }
+    bool operator!=(const char* s) const { return str != s; }
+
+  private:
+    std::string str;
+
+    static int find(size_t pos) { return pos == std::string::npos ? -1 : (int)pos; }
+};
+
+/* ---------------------------------------------------
+   Print / Stream
+--------------------------------------------------- */
+
+class Print {
+  public:
+    virtual ~Print() {}
+
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* buf, size_t len) {
+      size_t n = 0;
+      while (len-- && write(*buf++)) n++;
+      return n;
+    }
+    size_t write(const char* s) { return write((const uint8_t*)s, strlen(s)); }
+    size_t write(const char* buf, size_t len) { return write((const uint8_t*)buf, len); }
+    virtual int availableForWrite() { return 0; }
+    virtual void flush() {}
+
+    size_t print(const char* s) { return write(s); }
+    size_t print(const String& s) { return write(s.c_str()); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(unsigned char v, int base = DEC) { return print((unsigned long)v, base); }
+    size_t print(int v, int base = DEC) { return print((long)v, base); }
+    size_t print(unsigned int v, int base = DEC) { return print((unsigned long)v, base); }
+    size_t print(long v, int base = DEC);
+    size_t print(unsigned long v, int base = DEC);
+    size_t print(double v, int digits = 2);
+
+    size_t println() { return write("\r\n"); }
+    template <class T> size_t println(const T& v) { size_t n = print(v); return n + println(); }
+    template <class T> size_t println(const T& v, int fmt) { size_t n = print(v, fmt); return n + println(); }
+};
+
+class Stream : public Print {
+  public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+};
+
+class HardwareSerial : public Stream {
+  public:
+    void begin(unsigned long baud);
+    operator bool() const { return true; }
+
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* buf, size_t len) override;
+    using Print::write;
+    int availableForWrite() override { return 4096; }
+    void flush() override;
+
+    int available() override;
+    int read() override;
+    int peek() override;
+
+  private:
+    int peeked = -1;
+};
+
+extern HardwareSerial Serial;
+
+/* ---------------------------------------------------
+   Core functions
+--------------------------------------------------- */
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+void analogWrite(uint8_t pin, int val);
+int analogRead(uint8_t pin); // 10-bit noise: nothing is wired to the ADC
+
+// handlers run on the main thread, from host::stepWheels()
+void attachInterrupt(uint8_t interruptNum, void (*isr)(), int mode);
+void detachInterrupt(uint8_t interruptNum);
+inline void interrupts() {}
+inline void noInterrupts() {}
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+
+#endif
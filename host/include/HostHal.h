@@ -0,0 +1,66 @@
+#ifndef HOST_HAL_H
+#define HOST_HAL_H
+
+// knobs and probes of the Linux backend, for the simulator and host tools
+
+#include <Arduino.h>
+
+namespace host {
+
+  /* clock */
+  // frozen clock that only moves through advanceMicros() or delay()
+  void useVirtualClock(bool enabled);
+  void advanceMicros(unsigned long us);
+
+  /* watchdog */
+  bool watchdogStarted();
+  uint32_t watchdogResets();           // refreshes later than the WDT.begin() timeout
+  unsigned long watchdogLongestGapMs();
+
+  /* serial */
+  void setSerialEcho(bool enabled);    // false drops what the firmware prints
+
+  /* gpio / pwm / servo */
+  static const uint8_t NUM_PINS = 32;
+  uint8_t pinLevel(uint8_t pin);
+  int pwmValue(uint8_t pin);
+  int servoPulseUs(uint8_t pin);       // 0 when nothing is attached
+  uint32_t pinWrites(uint8_t pin);     // digitalWrite + analogWrite calls
+
+  /* wheels */
+  // first-order motor driven by one bridge channel, pulsing an encoder pin
+  // through whatever interrupt the firmware attached to it
+  struct WheelModel {
+    uint8_t en;
+    uint8_t in1;
+    uint8_t in2;
+    uint8_t encoderPin;
+    uint16_t countsPerSecAtFull = 130; // encoder rate at PWM 255, scale 100
+    uint16_t timeConstantMs = 120;
+    uint8_t deadbandPwm = 30;          // static friction: no motion below this
+    uint8_t scalePercent = 100;        // battery sag / load, set at runtime
+  };
+  uint8_t addWheel(const WheelModel& model); // returns its index
+  void setWheelScale(uint8_t index, uint8_t percent);
+  float wheelCountsPerSec(uint8_t index);
+  // run the plant up to now, firing encoder edges at their own timestamps
+  void stepWheels();
+
+  /* network */
+  // added to every port the firmware binds, so it runs unprivileged
+  void setPortOffset(uint16_t offset);
+  uint16_t portOffset();
+  void setLinkUp(bool up);             // simulated association with the AP
+  void setRssi(int32_t rssi);
+  void setJoinDelay(unsigned long ms); // from WiFi.begin() to joined, 0 by default
+  uint32_t clientWrites();             // WiFiClient::write calls, a byte write is one
+  uint32_t clientBytesWritten();
+
+  /* display */
+  String displayText(uint8_t row);     // text the firmware drew on that row
+  bool panelMatchesBuffer();           // everything drawn was also pushed
+  uint32_t panelBytesWritten();
+
+}
+
+#endif
@@ -0,0 +1,26 @@
+#ifndef HOST_SERVO_H
+#define HOST_SERVO_H
+
+#include <Arduino.h>
+
+// records the commanded pulse per pin, see host::servoPulseUs()
+class Servo {
+  public:
+    uint8_t attach(int pin) { return attach(pin, 544, 2400); }
+    uint8_t attach(int pin, int minUs, int maxUs);
+    void detach();
+    bool attached() const { return pin >= 0; }
+
+    void write(int value);
+    void writeMicroseconds(int us);
+    int read() const;
+    int readMicroseconds() const { return pulseUs; }
+
+  private:
+    int pin = -1;
+    int minUs = 544;
+    int maxUs = 2400;
+    int pulseUs = 1500;
+};
+
+#endif
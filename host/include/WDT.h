@@ -0,0 +1,16 @@
+#ifndef HOST_WDT_H
+#define HOST_WDT_H
+
+#include <Arduino.h>
+
+// the UNO R4 watchdog API; instead of resetting, a refresh that comes too
+// late is counted, see host::watchdogResets()
+class WDTimer {
+  public:
+    int begin(uint32_t timeoutMs);
+    void refresh();
+};
+
+extern WDTimer WDT;
+
+#endif
@@ -0,0 +1,129 @@
+#ifndef HOST_WIFIS3_H
+#define HOST_WIFIS3_H
+
+// WiFiS3 on top of non-blocking POSIX sockets; the link itself is simulated
+
+#include <Arduino.h>
+#include <memory>
+
+#define WL_IDLE_STATUS     0
+#define WL_NO_SSID_AVAIL   1
+#define WL_SCAN_COMPLETED  2
+#define WL_CONNECTED       3
+#define WL_CONNECT_FAILED  4
+#define WL_CONNECTION_LOST 5
+#define WL_DISCONNECTED    6
+
+class IPAddress {
+  public:
+    IPAddress() : addr(0) {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d)
+      : addr((uint32_t)a << 24 | (uint32_t)b << 16 | (uint32_t)c << 8 | d) {}
+    explicit IPAddress(uint32_t hostOrder) : addr(hostOrder) {}
+
+    uint8_t operator[](int i) const { return (addr >> (24 - 8 * i)) & 0xFF; }
+    bool operator==(const IPAddress& o) const { return addr == o.addr; }
+    bool operator!=(const IPAddress& o) const { return addr != o.addr; }
+    uint32_t hostOrder() const { return addr; }
+    String toString() const;
+
+  private:
+    uint32_t addr;
+};
+
+class WiFiClient : public Stream {
+  public:
+    WiFiClient() {}
+    explicit WiFiClient(int fd);
+
+    uint8_t connected();
+    operator bool() const;
+    void stop();
+
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* buf, size_t len) override;
+    using Print::write;
+
+    int available() override;
+    int read() override;
+    int read(uint8_t* buf, size_t len);
+    int peek() override;
+
+    IPAddress remoteIP();
+    uint16_t remotePort();
+
+    // copies share one socket, like handles into the WiFi module's socket table
+    bool operator==(const WiFiClient& o) const { return sock == o.sock; }
+    bool operator!=(const WiFiClient& o) const { return sock != o.sock; }
+
+  private:
+    struct Socket;
+    std::shared_ptr<Socket> sock;
+};
+
+class WiFiServer {
+  public:
+    explicit WiFiServer(uint16_t port) : port(port) {}
+    ~WiFiServer();
+
+    void begin();
+    WiFiClient available();
+    WiFiClient accept() { return available(); }
+
+  private:
+    uint16_t port;
+    int fd = -1;
+};
+
+class WiFiUDP : public Stream {
+  public:
+    ~WiFiUDP();
+
+    uint8_t begin(uint16_t port);
+    void stop();
+
+    int parsePacket();
+    int available() override;
+    int read() override;
+    int read(uint8_t* buf, size_t len);
+    int read(char* buf, size_t len) { return read((uint8_t*)buf, len); }
+    int peek() override;
+    IPAddress remoteIP() { return rxIp; }
+    uint16_t remotePort() { return rxPort; }
+
+    int beginPacket(IPAddress ip, uint16_t port);
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* buf, size_t len) override;
+    using Print::write;
+    int endPacket();
+
+  private:
+    static const size_t PACKET_SIZE = 1472;
+
+    int fd = -1;
+    uint8_t rx[PACKET_SIZE];
+    size_t rxLen = 0;
+    size_t rxPos = 0;
+    IPAddress rxIp;
+    uint16_t rxPort = 0;
+
+    uint8_t tx[PACKET_SIZE];
+    size_t txLen = 0;
+    IPAddress txIp;
+    uint16_t txPort = 0;
+};
+
+class WiFiClass {
+  public:
+    // starts the join, then waits for it like WiFiS3: up to setTimeout() ms
+    int begin(const char* ssid, const char* pass);
+    void setTimeout(unsigned long ms);
+    uint8_t status();
+    void disconnect();
+    IPAddress localIP();
+    int32_t RSSI();
+};
+
+extern WiFiClass WiFi;
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef HOST_WIRE_H
+#define HOST_WIRE_H
+
+#include <Arduino.h>
+
+// the only I2C device is the display, so transfers go straight to it
+class TwoWire {
+  public:
+    void begin() {}
+    void setClock(uint32_t) {}
+
+    void beginTransmission(uint8_t address);
+    size_t write(uint8_t c);
+    size_t write(const uint8_t* buf, size_t len);
+    uint8_t endTransmission(bool stop = true);
+
+  private:
+    uint8_t address = 0;
+    uint8_t buffer[32];
+    size_t length = 0;
+};
+
+extern TwoWire Wire;
+
+#endif
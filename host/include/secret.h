@@ -0,0 +1,8 @@
+#ifndef SECRET_H
+#define SECRET_H
+
+// the simulated link accepts any credentials
+#define WIFI_SSID     "rc-car-sim"
+#define WIFI_PASSWORD "rc-car-sim"
+
+#endif
@@ -0,0 +1,377 @@
+#include <Arduino.h>
+#include <Servo.h>
+#include <WDT.h>
+#include "HostHal.h"
+
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+HardwareSerial Serial;
+WDTimer WDT;
+
+namespace {
+  uint8_t levels[host::NUM_PINS];
+  int pwm[host::NUM_PINS];
+  int servoUs[host::NUM_PINS];
+  uint32_t writes[host::NUM_PINS];
+
+  void (*isrs[host::NUM_PINS])();
+  int isrModes[host::NUM_PINS];
+
+  bool serialEcho = true;
+
+  bool virtualClock = false;
+  uint64_t virtualUs = 0;
+  // what micros() reports while a simulated edge is being delivered
+  bool inIsr = false;
+  uint64_t isrUs = 0;
+
+  struct Wheel {
+    host::WheelModel model;
+    float countsPerSec = 0; // signed
+    float phase = 0;        // fraction of the way to the next edge
+    uint64_t lastUs = 0;
+  };
+  static const uint8_t MAX_WHEELS = 4;
+  Wheel wheels[MAX_WHEELS];
+  uint8_t wheelCount = 0;
+
+  bool watchdogRunning = false;
+  uint32_t watchdogTimeoutMs = 0;
+  unsigned long watchdogLastMs = 0;
+  unsigned long watchdogLongestMs = 0;
+  uint32_t watchdogBites = 0;
+
+  uint64_t monotonicUs() {
+    static uint64_t startUs = 0;
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    uint64_t us = (uint64_t)ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+    if (startUs == 0) startUs = us;
+    return us - startUs;
+  }
+
+  uint64_t nowUs() {
+    if (inIsr) return isrUs;
+    return virtualClock ? virtualUs : monotonicUs();
+  }
+
+  bool validPin(uint8_t pin) {
+    return pin < host::NUM_PINS;
+  }
+}
+
+/* ---------------------------------------------------
+   Serial (stdout / non-blocking stdin)
+--------------------------------------------------- */
+
+void HardwareSerial::begin(unsigned long) {
+  int flags = fcntl(STDIN_FILENO, F_GETFL, 0);
+  if (flags >= 0) fcntl(STDIN_FILENO, F_SETFL, flags | O_NONBLOCK);
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+  if (c == '\r' || !serialEcho) return 1; // terminals want plain \n
+  return fwrite(&c, 1, 1, stdout);
+}
+
+size_t HardwareSerial::write(const uint8_t* buf, size_t len) {
+  size_t n = 0;
+  for (size_t i = 0; i < len; ++i) n += write(buf[i]);
+  return n;
+}
+
+void HardwareSerial::flush() {
+  fflush(stdout);
+}
+
+int HardwareSerial::available() {
+  return peek() >= 0 ? 1 : 0;
+}
+
+int HardwareSerial::read() {
+  int c = peek();
+  peeked = -1;
+  return c;
+}
+
+int HardwareSerial::peek() {
+  if (peeked >= 0) return peeked;
+  uint8_t c;
+  if (::read(STDIN_FILENO, &c, 1) == 1) peeked = c;
+  return peeked;
+}
+
+/* ---------------------------------------------------
+   Print
+--------------------------------------------------- */
+
+size_t Print::print(long v, int base) {
+  if (base == DEC) {
+    char buf[24];
+    snprintf(buf, sizeof(buf), "%ld", v);
+    return write(buf);
+  }
+  return print((unsigned long)v, base);
+}
+
+size_t Print::print(unsigned long v, int base) {
+  char buf[8 * sizeof(long) + 1];
+  char* p = buf + sizeof(buf) - 1;
+  *p = '\0';
+  if (base < 2) base = 10;
+  do {
+    int d = v % base;
+    *--p = d < 10 ? '0' + d : 'A' + d - 10;
+    v /= base;
+  } while (v);
+  return write(p);
+}
+
+size_t Print::print(double v, int digits) {
+  char buf[48];
+  snprintf(buf, sizeof(buf), "%.*f", digits, v);
+  return write(buf);
+}
+
+/* ---------------------------------------------------
+   GPIO / PWM
+--------------------------------------------------- */
+
+void pinMode(uint8_t, uint8_t) {}
+
+void digitalWrite(uint8_t pin, uint8_t val) {
+  if (!validPin(pin)) return;
+  levels[pin] = val ? HIGH : LOW;
+  pwm[pin] = val ? 255 : 0;
+  writes[pin]++;
+}
+
+int digitalRead(uint8_t pin) {
+  return validPin(pin) ? levels[pin] : LOW;
+}
+
+void analogWrite(uint8_t pin, int val) {
+  if (!validPin(pin)) return;
+  pwm[pin] = constrain(val, 0, 255);
+  levels[pin] = pwm[pin] > 0 ? HIGH : LOW;
+  writes[pin]++;
+}
+
+int analogRead(uint8_t pin) {
+  return (int)((monotonicUs() * 2654435761u) >> 22) & 0x3FF;
+}
+
+void attachInterrupt(uint8_t pin, void (*isr)(), int mode) {
+  if (!validPin(pin)) return;
+  isrs[pin] = isr;
+  isrModes[pin] = mode;
+}
+
+void detachInterrupt(uint8_t pin) {
+  if (validPin(pin)) isrs[pin] = nullptr;
+}
+
+/* ---------------------------------------------------
+   Servo
+--------------------------------------------------- */
+
+uint8_t Servo::attach(int p, int lo, int hi) {
+  if (p < 0 || p >= host::NUM_PINS) return 0;
+  pin = p;
+  minUs = lo;
+  maxUs = hi;
+  servoUs[pin] = pulseUs;
+  return 1;
+}
+
+void Servo::detach() {
+  if (pin >= 0) servoUs[pin] = 0;
+  pin = -1;
+}
+
+void Servo::write(int value) {
+  // like the core: small values are degrees, larger ones microseconds
+  if (value < minUs) {
+    value = constrain(value, 0, 180);
+    value = minUs + (long)value * (maxUs - minUs) / 180;
+  }
+  writeMicroseconds(value);
+}
+
+void Servo::writeMicroseconds(int us) {
+  pulseUs = constrain(us, minUs, maxUs);
+  if (pin >= 0) {
+    servoUs[pin] = pulseUs;
+    writes[pin]++;
+  }
+}
+
+int Servo::read() const {
+  return ((long)(pulseUs - minUs) * 180 + (maxUs - minUs) / 2) / (maxUs - minUs);
+}
+
+/* ---------------------------------------------------
+   Time / random
+--------------------------------------------------- */
+
+unsigned long millis() {
+  return (unsigned long)(nowUs() / 1000);
+}
+
+unsigned long micros() {
+  // 32-bit like the target, so wraparound behaves the same
+  return (uint32_t)nowUs();
+}
+
+void delay(unsigned long ms) {
+  if (virtualClock) {
+    virtualUs += (uint64_t)ms * 1000;
+    return;
+  }
+  usleep(ms * 1000);
+}
+
+void delayMicroseconds(unsigned int us) {
+  if (virtualClock) {
+    virtualUs += us;
+    return;
+  }
+  usleep(us);
+}
+
+/* ---------------------------------------------------
+   Watchdog
+--------------------------------------------------- */
+
+int WDTimer::begin(uint32_t timeoutMs) {
+  watchdogRunning = true;
+  watchdogTimeoutMs = timeoutMs;
+  watchdogLastMs = millis();
+  return 1;
+}
+
+void WDTimer::refresh() {
+  if (!watchdogRunning) return;
+  unsigned long now = millis();
+  unsigned long gap = now - watchdogLastMs;
+  if (gap > watchdogLongestMs) watchdogLongestMs = gap;
+  if (gap > watchdogTimeoutMs) watchdogBites++; // the board would have reset
+  watchdogLastMs = now;
+}
+
+long random(long howbig) {
+  if (howbig <= 0) return 0;
+  return ::random() % howbig;
+}
+
+long random(long howsmall, long howbig) {
+  if (howsmall >= howbig) return howsmall;
+  return howsmall + random(howbig - howsmall);
+}
+
+void randomSeed(unsigned long seed) {
+  srandom(seed);
+}
+
+/* ---------------------------------------------------
+   host:: probes
+--------------------------------------------------- */
+
+namespace host {
+
+  void setSerialEcho(bool enabled) {
+    serialEcho = enabled;
+  }
+
+  bool watchdogStarted() {
+    return watchdogRunning;
+  }
+
+  uint32_t watchdogResets() {
+    return watchdogBites;
+  }
+
+  unsigned long watchdogLongestGapMs() {
+    return watchdogLongestMs;
+  }
+
+  void useVirtualClock(bool enabled) {
+    if (enabled && !virtualClock) virtualUs = monotonicUs();
+    virtualClock = enabled;
+  }
+
+  void advanceMicros(unsigned long us) {
+    virtualUs += us;
+  }
+
+  uint8_t pinLevel(uint8_t pin) {
+    return validPin(pin) ? levels[pin] : LOW;
+  }
+
+  int pwmValue(uint8_t pin) {
+    return validPin(pin) ? pwm[pin] : 0;
+  }
+
+  int servoPulseUs(uint8_t pin) {
+    return validPin(pin) ? servoUs[pin] : 0;
+  }
+
+  uint32_t pinWrites(uint8_t pin) {
+    return validPin(pin) ? writes[pin] : 0;
+  }
+
+  uint8_t addWheel(const WheelModel& model) {
+    if (wheelCount >= MAX_WHEELS) return MAX_WHEELS;
+    Wheel& w = wheels[wheelCount];
+    w.model = model;
+    w.lastUs = nowUs();
+    return wheelCount++;
+  }
+
+  void setWheelScale(uint8_t index, uint8_t percent) {
+    if (index < wheelCount) wheels[index].model.scalePercent = percent;
+  }
+
+  float wheelCountsPerSec(uint8_t index) {
+    return index < wheelCount ? wheels[index].countsPerSec : 0;
+  }
+
+  void stepWheels() {
+    uint64_t now = nowUs();
+    for (uint8_t i = 0; i < wheelCount; ++i) {
+      Wheel& w = wheels[i];
+      const WheelModel& m = w.model;
+      if (now <= w.lastUs) continue;
+      float dt = (now - w.lastUs) / 1e6f;
+
+      // the bridge decides direction, ENx how hard
+      int sign = levels[m.in1] && !levels[m.in2] ? 1 : (levels[m.in2] && !levels[m.in1] ? -1 : 0);
+      int duty = pwm[m.en] > m.deadbandPwm ? pwm[m.en] : 0;
+      float target = sign * duty / 255.0f * m.countsPerSecAtFull * m.scalePercent / 100.0f;
+
+      float before = w.countsPerSec;
+      w.countsPerSec = target + (before - target) * expf(-dt * 1000.0f / m.timeConstantMs);
+      float rate = fabsf(before + w.countsPerSec) / 2;
+
+      // one rising edge per count, placed where it falls inside the step
+      float phase = w.phase + rate * dt;
+      uint64_t startUs = w.lastUs;
+      for (float edge = 1.0f; edge <= phase; edge += 1.0f) {
+        uint8_t pin = m.encoderPin;
+        levels[pin] = HIGH;
+        if (isrs[pin] && isrModes[pin] != FALLING) {
+          isrUs = startUs + (uint64_t)((edge - w.phase) / rate * 1e6f);
+          inIsr = true;
+          isrs[pin]();
+          inIsr = false;
+        }
+        levels[pin] = LOW;
+      }
+      w.phase = phase - floorf(phase);
+      w.lastUs = now;
+    }
+  }
+
+}
@@ -0,0 +1,220 @@
+#include <Adafruit_SSD1306.h>
+#include "HostHal.h"
+
+TwoWire Wire;
+
+namespace {
+  // model of the SSD1306 GDDRAM and its addressing window
+  const uint8_t PANEL_W = 128;
+  const uint8_t PANEL_PAGES = 8;
+  uint8_t panel[PANEL_PAGES][PANEL_W];
+  uint8_t colStart = 0, colEnd = PANEL_W - 1, col = 0;
+  uint8_t pageStart = 0, pageEnd = PANEL_PAGES - 1, page = 0;
+  uint32_t panelBytes = 0;
+
+  // multi-byte commands arrive one byte at a time
+  uint8_t pendingCmd = 0;
+  uint8_t pendingArgs = 0;
+  uint8_t args[2];
+
+  Adafruit_SSD1306* activeDisplay = nullptr;
+
+  void panelData(uint8_t b) {
+    panel[page][col] = b;
+    panelBytes++;
+    if (col < colEnd) {
+      col++;
+      return;
+    }
+    col = colStart;
+    page = page < pageEnd ? page + 1 : pageStart;
+  }
+
+  void panelCommand(uint8_t c) {
+    if (pendingArgs > 0) {
+      args[2 - pendingArgs] = c;
+      if (--pendingArgs > 0) return;
+
+      if (pendingCmd == SSD1306_COLUMNADDR) {
+        colStart = col = args[0] % PANEL_W;
+        colEnd = args[1] % PANEL_W;
+      } else {
+        pageStart = page = args[0] % PANEL_PAGES;
+        pageEnd = args[1] % PANEL_PAGES;
+      }
+      return;
+    }
+    if (c == SSD1306_COLUMNADDR || c == SSD1306_PAGEADDR) {
+      pendingCmd = c;
+      pendingArgs = 2;
+    }
+    // everything else (contrast, charge pump, ...) has no visible effect here
+  }
+}
+
+/* ---------------------------------------------------
+   Wire
+--------------------------------------------------- */
+
+void TwoWire::beginTransmission(uint8_t addr) {
+  address = addr;
+  length = 0;
+}
+
+size_t TwoWire::write(uint8_t c) {
+  if (length >= sizeof(buffer)) return 0;
+  buffer[length++] = c;
+  return 1;
+}
+
+size_t TwoWire::write(const uint8_t* buf, size_t len) {
+  size_t n = 0;
+  while (n < len && write(buf[n])) n++;
+  return n;
+}
+
+uint8_t TwoWire::endTransmission(bool) {
+  if (length == 0) return 0;
+  // first byte is the SSD1306 control byte: 0x00 command, 0x40 data
+  bool data = buffer[0] & 0x40;
+  for (size_t i = 1; i < length; ++i) {
+    if (data) panelData(buffer[i]);
+    else panelCommand(buffer[i]);
+  }
+  length = 0;
+  return 0;
+}
+
+/* ---------------------------------------------------
+   Adafruit_GFX (text grid)
+--------------------------------------------------- */
+
+Adafruit_GFX::Adafruit_GFX(int16_t w, int16_t h) : _width(w), _height(h) {
+  memset(cells, ' ', sizeof(cells));
+}
+
+void Adafruit_GFX::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  for (int16_t j = y; j < y + h; ++j) {
+    for (int16_t i = x; i < x + w; ++i) drawPixel(i, j, color);
+  }
+
+  // forget the characters whose cells were painted over
+  for (int16_t r = y / CELL_H; r <= (y + h - 1) / CELL_H && r < MAX_ROWS; ++r) {
+    for (int16_t c = x / CELL_W; c <= (x + w - 1) / CELL_W && c < MAX_COLS; ++c) {
+      if (r >= 0 && c >= 0) cells[r][c] = ' ';
+    }
+  }
+}
+
+size_t Adafruit_GFX::write(uint8_t ch) {
+  if (ch == '\n') {
+    cursorX = 0;
+    cursorY += CELL_H;
+    return 1;
+  }
+  if (ch == '\r') return 1;
+  if (cursorX + CELL_W > _width) {
+    if (!wrap) return 1;
+    cursorX = 0;
+    cursorY += CELL_H;
+  }
+
+  int16_t r = cursorY / CELL_H;
+  int16_t c = cursorX / CELL_W;
+  if (r >= 0 && r < MAX_ROWS && c >= 0 && c < MAX_COLS) cells[r][c] = ch;
+
+  // placeholder glyph: the character code as a 5 px wide column pattern
+  for (int16_t i = 0; i < CELL_W - 1; ++i) {
+    for (int16_t j = 0; j < CELL_H; ++j) {
+      bool on = ch != ' ' && ((ch >> (j % 8)) & 1);
+      drawPixel(cursorX + i, cursorY + j, on ? textColor : !textColor);
+    }
+  }
+  cursorX += CELL_W;
+  return 1;
+}
+
+String Adafruit_GFX::textRow(uint8_t row) const {
+  if (row >= MAX_ROWS) return String();
+  int16_t n = _width / CELL_W;
+  if (n > MAX_COLS) n = MAX_COLS;
+  while (n > 0 && cells[row][n - 1] == ' ') n--;
+  return String(std::string(cells[row], n));
+}
+
+/* ---------------------------------------------------
+   Adafruit_SSD1306
+--------------------------------------------------- */
+
+Adafruit_SSD1306::Adafruit_SSD1306(uint8_t w, uint8_t h, TwoWire*, int8_t, uint32_t, uint32_t)
+  : Adafruit_GFX(w, h), buffer(new uint8_t[w * ((h + 7) / 8)]()) {
+  activeDisplay = this;
+}
+
+Adafruit_SSD1306::~Adafruit_SSD1306() {
+  if (activeDisplay == this) activeDisplay = nullptr;
+  delete[] buffer;
+}
+
+bool Adafruit_SSD1306::begin(uint8_t, uint8_t) {
+  return true;
+}
+
+void Adafruit_SSD1306::clearDisplay() {
+  fillScreen(BLACK);
+}
+
+void Adafruit_SSD1306::display() {
+  // full-frame push, the way the library does it
+  ssd1306_command(SSD1306_PAGEADDR);
+  ssd1306_command(0);
+  ssd1306_command((_height + 7) / 8 - 1);
+  ssd1306_command(SSD1306_COLUMNADDR);
+  ssd1306_command(0);
+  ssd1306_command(_width - 1);
+
+  size_t total = (size_t)_width * ((_height + 7) / 8);
+  for (size_t i = 0; i < total; i += 31) {
+    size_t chunk = total - i < 31 ? total - i : 31;
+    Wire.beginTransmission(0x3C);
+    Wire.write((uint8_t)0x40);
+    Wire.write(buffer + i, chunk);
+    Wire.endTransmission();
+  }
+}
+
+void Adafruit_SSD1306::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  if (x < 0 || y < 0 || x >= _width || y >= _height) return;
+  uint8_t& b = buffer[x + (y / 8) * _width];
+  if (color) b |= 1 << (y & 7);
+  else b &= ~(1 << (y & 7));
+}
+
+void Adafruit_SSD1306::ssd1306_command(uint8_t c) {
+  Wire.beginTransmission(0x3C);
+  Wire.write((uint8_t)0x00);
+  Wire.write(c);
+  Wire.endTransmission();
+}
+
+namespace host {
+
+  String displayText(uint8_t row) {
+    return activeDisplay ? activeDisplay->textRow(row) : String();
+  }
+
+  bool panelMatchesBuffer() {
+    if (!activeDisplay) return true;
+    const uint8_t* buf = activeDisplay->getBuffer();
+    uint8_t pages = (activeDisplay->height() + 7) / 8;
+    for (uint8_t p = 0; p < pages; ++p) {
+      if (memcmp(panel[p], buf + p * activeDisplay->width(), activeDisplay->width()) != 0) return false;
+    }
+    return true;
+  }
+
+  uint32_t panelBytesWritten() {
+    return panelBytes;
+  }
+
+}
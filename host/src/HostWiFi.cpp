@@ -0,0 +1,346 @@
+#include <WiFiS3.h>
+#include "HostHal.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+
+WiFiClass WiFi;
+
+namespace {
+  uint16_t portOffsetValue = 8000;
+  bool linkUp = true;
+  bool joined = false;
+  bool joining = false;
+  unsigned long joinStartMs = 0;
+  unsigned long joinDelayMs = 0;     // association time once the AP is in reach
+  unsigned long beginTimeoutMs = 10000; // WiFiS3's default
+  int32_t rssiValue = -55;
+
+  // what the firmware handed to TCP clients; each write is a call into the module
+  uint32_t clientWriteCalls = 0;
+  uint32_t clientWriteBytes = 0;
+
+  // how long a write may wait for socket space, the module blocks similarly
+  const int WRITE_TIMEOUT_MS = 200;
+
+  void setNonBlocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+  }
+
+  sockaddr_in toSockaddr(IPAddress ip, uint16_t port) {
+    sockaddr_in sa = {};
+    sa.sin_family = AF_INET;
+    sa.sin_addr.s_addr = htonl(ip.hostOrder());
+    sa.sin_port = htons(port);
+    return sa;
+  }
+}
+
+String IPAddress::toString() const {
+  char buf[16];
+  snprintf(buf, sizeof(buf), "%u.%u.%u.%u", (*this)[0], (*this)[1], (*this)[2], (*this)[3]);
+  return String(buf);
+}
+
+/* ---------------------------------------------------
+   WiFiClient
+--------------------------------------------------- */
+
+struct WiFiClient::Socket {
+  int fd;
+  explicit Socket(int fd) : fd(fd) {}
+  ~Socket() { if (fd >= 0) ::close(fd); }
+};
+
+WiFiClient::WiFiClient(int fd) : sock(std::make_shared<Socket>(fd)) {}
+
+uint8_t WiFiClient::connected() {
+  if (!sock || sock->fd < 0) return 0;
+  uint8_t c;
+  ssize_t n = recv(sock->fd, &c, 1, MSG_PEEK | MSG_DONTWAIT);
+  if (n > 0) return 1;
+  if (n == 0) return 0; // orderly shutdown from the peer
+  return (errno == EAGAIN || errno == EWOULDBLOCK) ? 1 : 0;
+}
+
+WiFiClient::operator bool() const {
+  return sock && sock->fd >= 0;
+}
+
+void WiFiClient::stop() {
+  if (!sock || sock->fd < 0) return;
+  ::close(sock->fd);
+  sock->fd = -1;
+}
+
+size_t WiFiClient::write(uint8_t c) {
+  return write(&c, 1);
+}
+
+size_t WiFiClient::write(const uint8_t* buf, size_t len) {
+  if (!sock || sock->fd < 0) return 0;
+  clientWriteCalls++;
+  clientWriteBytes += len;
+
+  size_t done = 0;
+  while (done < len) {
+    ssize_t n = send(sock->fd, buf + done, len - done, MSG_NOSIGNAL);
+    if (n > 0) {
+      done += n;
+      continue;
+    }
+    if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+      pollfd p = {sock->fd, POLLOUT, 0};
+      if (poll(&p, 1, WRITE_TIMEOUT_MS) > 0) continue;
+    }
+    break;
+  }
+  return done;
+}
+
+int WiFiClient::available() {
+  if (!sock || sock->fd < 0) return 0;
+  int n = 0;
+  if (ioctl(sock->fd, FIONREAD, &n) < 0) return 0;
+  return n;
+}
+
+int WiFiClient::read() {
+  uint8_t c;
+  return read(&c, 1) == 1 ? c : -1;
+}
+
+int WiFiClient::read(uint8_t* buf, size_t len) {
+  if (!sock || sock->fd < 0) return -1;
+  ssize_t n = recv(sock->fd, buf, len, MSG_DONTWAIT);
+  return n > 0 ? (int)n : -1;
+}
+
+int WiFiClient::peek() {
+  if (!sock || sock->fd < 0) return -1;
+  uint8_t c;
+  return recv(sock->fd, &c, 1, MSG_PEEK | MSG_DONTWAIT) == 1 ? c : -1;
+}
+
+IPAddress WiFiClient::remoteIP() {
+  sockaddr_in sa = {};
+  socklen_t len = sizeof(sa);
+  if (!sock || getpeername(sock->fd, (sockaddr*)&sa, &len) < 0) return IPAddress();
+  return IPAddress(ntohl(sa.sin_addr.s_addr));
+}
+
+uint16_t WiFiClient::remotePort() {
+  sockaddr_in sa = {};
+  socklen_t len = sizeof(sa);
+  if (!sock || getpeername(sock->fd, (sockaddr*)&sa, &len) < 0) return 0;
+  return ntohs(sa.sin_port);
+}
+
+/* ---------------------------------------------------
+   WiFiServer
+--------------------------------------------------- */
+
+WiFiServer::~WiFiServer() {
+  if (fd >= 0) ::close(fd);
+}
+
+void WiFiServer::begin() {
+  if (fd >= 0) return;
+  fd = socket(AF_INET, SOCK_STREAM, 0);
+  if (fd < 0) return;
+
+  int one = 1;
+  setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+  sockaddr_in sa = toSockaddr(IPAddress(0, 0, 0, 0), port + portOffsetValue);
+  if (bind(fd, (sockaddr*)&sa, sizeof(sa)) < 0 || listen(fd, 8) < 0) {
+    perror("<host> tcp listen");
+    ::close(fd);
+    fd = -1;
+    return;
+  }
+  setNonBlocking(fd);
+}
+
+WiFiClient WiFiServer::available() {
+  if (fd < 0 || !linkUp) return WiFiClient();
+  int c = ::accept(fd, nullptr, nullptr);
+  if (c < 0) return WiFiClient();
+
+  setNonBlocking(c);
+  int one = 1;
+  setsockopt(c, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+  return WiFiClient(c);
+}
+
+/* ---------------------------------------------------
+   WiFiUDP
+--------------------------------------------------- */
+
+WiFiUDP::~WiFiUDP() {
+  stop();
+}
+
+uint8_t WiFiUDP::begin(uint16_t port) {
+  stop();
+  fd = socket(AF_INET, SOCK_DGRAM, 0);
+  if (fd < 0) return 0;
+
+  int one = 1;
+  setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+  sockaddr_in sa = toSockaddr(IPAddress(0, 0, 0, 0), port + portOffsetValue);
+  if (bind(fd, (sockaddr*)&sa, sizeof(sa)) < 0) {
+    perror("<host> udp bind");
+    stop();
+    return 0;
+  }
+  setNonBlocking(fd);
+  return 1;
+}
+
+void WiFiUDP::stop() {
+  if (fd >= 0) ::close(fd);
+  fd = -1;
+}
+
+int WiFiUDP::parsePacket() {
+  rxLen = rxPos = 0;
+  if (fd < 0 || !linkUp) return 0;
+
+  sockaddr_in sa = {};
+  socklen_t len = sizeof(sa);
+  ssize_t n = recvfrom(fd, rx, sizeof(rx), MSG_DONTWAIT, (sockaddr*)&sa, &len);
+  if (n <= 0) return 0;
+
+  rxLen = n;
+  rxIp = IPAddress(ntohl(sa.sin_addr.s_addr));
+  rxPort = ntohs(sa.sin_port);
+  return (int)n;
+}
+
+int WiFiUDP::available() {
+  return (int)(rxLen - rxPos);
+}
+
+int WiFiUDP::read() {
+  return rxPos < rxLen ? rx[rxPos++] : -1;
+}
+
+int WiFiUDP::read(uint8_t* buf, size_t len) {
+  size_t n = rxLen - rxPos;
+  if (n > len) n = len;
+  memcpy(buf, rx + rxPos, n);
+  rxPos += n;
+  return (int)n;
+}
+
+int WiFiUDP::peek() {
+  return rxPos < rxLen ? rx[rxPos] : -1;
+}
+
+int WiFiUDP::beginPacket(IPAddress ip, uint16_t port) {
+  txIp = ip;
+  txPort = port;
+  txLen = 0;
+  return fd >= 0;
+}
+
+size_t WiFiUDP::write(uint8_t c) {
+  return write(&c, 1);
+}
+
+size_t WiFiUDP::write(const uint8_t* buf, size_t len) {
+  if (len > sizeof(tx) - txLen) len = sizeof(tx) - txLen;
+  memcpy(tx + txLen, buf, len);
+  txLen += len;
+  return len;
+}
+
+int WiFiUDP::endPacket() {
+  if (fd < 0 || !linkUp) return 0;
+  sockaddr_in sa = toSockaddr(txIp, txPort);
+  return sendto(fd, tx, txLen, 0, (sockaddr*)&sa, sizeof(sa)) == (ssize_t)txLen;
+}
+
+/* ---------------------------------------------------
+   WiFiClass (simulated association)
+--------------------------------------------------- */
+
+int WiFiClass::begin(const char*, const char*) {
+  joined = false;
+  joining = true;
+  joinStartMs = millis();
+
+  unsigned long start = millis();
+  while (millis() - start < beginTimeoutMs) {
+    if (status() == WL_CONNECTED) return WL_CONNECTED;
+    delay(1);
+  }
+  return WL_CONNECT_FAILED;
+}
+
+void WiFiClass::setTimeout(unsigned long ms) {
+  beginTimeoutMs = ms;
+}
+
+uint8_t WiFiClass::status() {
+  if (!linkUp) {
+    joined = false;
+  } else if (joining && millis() - joinStartMs >= joinDelayMs) {
+    joining = false;
+    joined = true;
+  }
+  return joined ? WL_CONNECTED : WL_DISCONNECTED;
+}
+
+void WiFiClass::disconnect() {
+  joined = false;
+  joining = false;
+}
+
+IPAddress WiFiClass::localIP() {
+  return joined ? IPAddress(127, 0, 0, 1) : IPAddress();
+}
+
+int32_t WiFiClass::RSSI() {
+  return joined ? rssiValue : 0;
+}
+
+namespace host {
+
+  void setPortOffset(uint16_t offset) {
+    portOffsetValue = offset;
+  }
+
+  uint16_t portOffset() {
+    return portOffsetValue;
+  }
+
+  void setLinkUp(bool up) {
+    linkUp = up;
+  }
+
+  void setRssi(int32_t rssi) {
+    rssiValue = rssi;
+  }
+
+  void setJoinDelay(unsigned long ms) {
+    joinDelayMs = ms;
+  }
+
+  uint32_t clientWrites() {
+    return clientWriteCalls;
+  }
+
+  uint32_t clientBytesWritten() {
+    return clientWriteBytes;
+  }
+
+}
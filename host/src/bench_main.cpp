@@ -0,0 +1,571 @@
+// load generator for the HTTP / WebSocket control path: runs the firmware in
+// this process against real sockets and drives it with scripted operator
+// traffic, then reports throughput, latency, drops, heap use and socket
+// writes as JSON
+
+#include <Arduino.h>
+#include "HostHal.h"
+#include "StateManager.h"
+#include "secret.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <new>
+
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+/* ---------------------------------------------------
+   Heap accounting
+--------------------------------------------------- */
+
+// every allocation carries its size and whether it was counted; client
+// threads switch counting off so only the firmware and its backend show up
+namespace {
+  thread_local bool countHeap = true;
+  std::atomic<long> heapNow(0);
+  std::atomic<long> heapPeak(0);
+
+  struct alignas(16) HeapHeader {
+    size_t size;
+    bool counted;
+  };
+
+  void* allocate(size_t n) {
+    HeapHeader* h = (HeapHeader*)malloc(sizeof(HeapHeader) + n);
+    if (!h) throw std::bad_alloc();
+    h->size = n;
+    h->counted = countHeap;
+    if (h->counted) {
+      long now = heapNow += (long)n;
+      long peak = heapPeak.load();
+      while (now > peak && !heapPeak.compare_exchange_weak(peak, now)) {}
+    }
+    return h + 1;
+  }
+
+  void release(void* p) {
+    if (!p) return;
+    HeapHeader* h = (HeapHeader*)p - 1;
+    if (h->counted) heapNow -= (long)h->size;
+    free(h);
+  }
+}
+
+void* operator new(size_t n) { return allocate(n); }
+void* operator new[](size_t n) { return allocate(n); }
+void operator delete(void* p) noexcept { release(p); }
+void operator delete[](void* p) noexcept { release(p); }
+void operator delete(void* p, size_t) noexcept { release(p); }
+void operator delete[](void* p, size_t) noexcept { release(p); }
+
+namespace {
+
+  /* ---------------------------------------------------
+     Configuration
+  --------------------------------------------------- */
+
+  enum Transport { HTTP, WEBSOCKET };
+  enum Pattern { SLIDER, KEYS };
+
+  struct Config {
+    const char* scenario = "custom";
+    unsigned clients = 1;      // operator tabs sending commands
+    float rateHz = 30;         // commands per second per client
+    Transport transport = HTTP;
+    Pattern pattern = SLIDER;
+    float churnHz = 0;         // page reloads per second (GET / + a WebSocket reopen)
+    float durationS = 10;
+    uint16_t portOffset = 24000;
+    unsigned long idleUs = 100;
+    const char* json = nullptr; // stdout when null
+  };
+
+  // operator behaviours worth tracking, flags given later override them
+  struct Preset {
+    const char* name;
+    unsigned clients;
+    float rateHz;
+    Transport transport;
+    Pattern pattern;
+    float churnHz;
+  };
+  const Preset PRESETS[] = {
+    {"slider", 1, 60, HTTP, SLIDER, 0},     // dragging the speed slider
+    {"keys", 1, 40, HTTP, KEYS, 0},         // mashing the arrow keys
+    {"tabs", 2, 20, WEBSOCKET, SLIDER, 0},  // several pages open at once, up to MAX_WEBSOCKETS
+    {"reload", 1, 30, WEBSOCKET, KEYS, 1},  // reloading the page mid-drive
+    {"mixed", 2, 30, HTTP, KEYS, 0.5f},
+    {"page", 0, 30, HTTP, SLIDER, 20},      // page loads alone, for writes per load
+  };
+
+  void usage(const char* argv0) {
+    fprintf(stderr,
+            "usage: %s [--scenario NAME] [--clients N] [--rate HZ] [--transport http|ws]\n"
+            "          [--pattern slider|keys] [--churn HZ] [--duration S] [--json FILE]\n"
+            "          [--port-offset N] [--idle-us N]\n"
+            "  scenarios: slider keys tabs reload mixed page (flags after it override)\n",
+            argv0);
+  }
+
+  /* ---------------------------------------------------
+     Shared state between clients and the firmware loop
+  --------------------------------------------------- */
+
+  std::atomic<bool> stopping(false);
+  std::atomic<unsigned> clientsRunning(0);
+  std::atomic<uint32_t> sentUs[65536]; // by seq, 0 = not outstanding
+  // each client numbers its own frames, as every open page does; they start
+  // a quarter of the sequence space apart so an ack still names one frame
+  const uint16_t CLIENT_SEQ_SPACING = 0x4000;
+  uint16_t httpPort = 0;
+
+  struct ClientStats {
+    uint32_t requests = 0;
+    uint32_t ok = 0;
+    uint32_t rejected = 0; // 409: stale or refused
+    uint32_t failed = 0;   // no answer, dropped connection, 5xx
+    uint32_t refused = 0;  // control channels the car turned away (all in use)
+    uint32_t commands = 0;
+    std::vector<uint32_t> requestUs;
+  };
+
+  uint32_t nowUs() {
+    return micros();
+  }
+
+  /* ---------------------------------------------------
+     Sockets
+  --------------------------------------------------- */
+
+  int openSocket() {
+    int s = socket(AF_INET, SOCK_STREAM, 0);
+    if (s < 0) return -1;
+    int one = 1;
+    setsockopt(s, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    timeval tv = {2, 0};
+    setsockopt(s, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(httpPort);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (connect(s, (sockaddr*)&addr, sizeof(addr)) < 0) {
+      close(s);
+      return -1;
+    }
+    return s;
+  }
+
+  bool sendAll(int s, const char* data, size_t len) {
+    while (len > 0) {
+      ssize_t n = send(s, data, len, MSG_NOSIGNAL);
+      if (n <= 0) return false;
+      data += n;
+      len -= n;
+    }
+    return true;
+  }
+
+  // one request on its own connection (the server closes after each);
+  // returns the status code, or -1
+  int httpRequest(const char* request, size_t len, uint32_t* stampSeq, ClientStats& st) {
+    uint32_t start = nowUs();
+    int s = openSocket();
+    if (s < 0) return -1;
+    if (stampSeq) sentUs[*stampSeq & 0xFFFF] = nowUs() | 1;
+    int status = -1;
+    if (sendAll(s, request, len)) {
+      char buf[2048];
+      size_t got = 0;
+      ssize_t n;
+      // read to EOF; only the status line matters
+      while ((n = recv(s, buf + (got < 16 ? got : 16), sizeof(buf) - 16, 0)) > 0) {
+        if (got < 16) got += n;
+      }
+      if (got >= 12 && memcmp(buf, "HTTP/1.1 ", 9) == 0) status = atoi(buf + 9);
+    }
+    close(s);
+    st.requestUs.push_back(nowUs() - start);
+    return status;
+  }
+
+  /* ---------------------------------------------------
+     Operator model
+  --------------------------------------------------- */
+
+  struct Intent {
+    uint8_t throttle = 0;
+    uint8_t dir = 2;
+    int8_t steer = 0;
+  };
+
+  Intent nextIntent(Pattern pattern, uint32_t tick, unsigned client) {
+    Intent in;
+    if (pattern == SLIDER) {
+      // triangle sweep over two seconds at 30 Hz
+      uint32_t phase = (tick * 4 + client * 37) % 120;
+      in.throttle = (uint8_t)((phase < 60 ? phase : 120 - phase) * 255 / 60);
+      in.dir = 0;
+    } else {
+      // a key goes down or up on every tick
+      static const uint8_t dirs[] = {0, 0, 2, 1, 0, 2};
+      static const int8_t steers[] = {0, -100, 0, 100, 100, 0};
+      uint32_t k = (tick * 7 + client * 3) % 6;
+      in.throttle = 200;
+      in.dir = dirs[k];
+      in.steer = steers[(k + tick) % 6];
+    }
+    return in;
+  }
+
+  void encodeFrame(uint8_t frame[8], uint8_t flags, uint16_t seq, const Intent& in) {
+    frame[0] = CONTROL_FRAME_VERSION;
+    frame[1] = flags;
+    frame[2] = seq & 0xFF;
+    frame[3] = seq >> 8;
+    frame[4] = in.throttle;
+    frame[5] = in.dir;
+    frame[6] = (uint8_t)in.steer;
+    frame[7] = 0;
+    for (int i = 0; i < 7; ++i) frame[7] ^= frame[i];
+  }
+
+  // -1 when it failed, -2 when the car answered but had no channel free
+  int openWebSocket() {
+    int s = openSocket();
+    if (s < 0) return -1;
+    static const char upgrade[] =
+        "GET /ws HTTP/1.1\r\nHost: car\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+        "Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\nSec-WebSocket-Version: 13\r\n\r\n";
+    char buf[256];
+    ssize_t n;
+    if (!sendAll(s, upgrade, sizeof(upgrade) - 1) || (n = recv(s, buf, sizeof(buf) - 1, 0)) < 12) {
+      close(s);
+      return -1;
+    }
+    if (memcmp(buf, "HTTP/1.1 101", 12) != 0) {
+      close(s);
+      return memcmp(buf, "HTTP/1.1 503", 12) == 0 ? -2 : -1;
+    }
+    return s;
+  }
+
+  bool sendWebSocketFrame(int s, const uint8_t payload[8]) {
+    // client frames are masked; a zero mask keeps the payload as is
+    uint8_t msg[2 + 4 + 8] = {0x82, 0x80 | 8, 0, 0, 0, 0};
+    memcpy(msg + 6, payload, 8);
+    // throw away pings and anything else the server sends
+    char drain[256];
+    while (recv(s, drain, sizeof(drain), MSG_DONTWAIT) > 0) {}
+    return sendAll(s, (const char*)msg, sizeof(msg));
+  }
+
+  void commandClient(const Config& cfg, unsigned id, ClientStats& st) {
+    countHeap = false;
+    uint32_t periodUs = (uint32_t)(1e6f / cfg.rateHz);
+    uint32_t next = nowUs();
+    bool first = true;
+    int ws = -1;
+    uint16_t seq = (uint16_t)(id * CLIENT_SEQ_SPACING);
+
+    for (uint32_t tick = 0; !stopping; ++tick) {
+      Intent in = nextIntent(cfg.pattern, tick, id);
+      seq++;
+      uint32_t seq32 = seq;
+      uint8_t flags = first ? 1 : 0; // RESYNC
+
+      if (cfg.transport == WEBSOCKET) {
+        if (ws < 0) {
+          ws = openWebSocket();
+          flags = 1;
+        }
+        if (ws == -2) {
+          // no channel for this tab; nothing was sent, so nothing to count
+          // against the car's request handling
+          st.refused++;
+        } else {
+          st.commands++;
+          uint8_t frame[8];
+          encodeFrame(frame, flags, seq, in);
+          st.requests++;
+          sentUs[seq] = nowUs() | 1;
+          if (ws < 0 || !sendWebSocketFrame(ws, frame)) {
+            st.failed++;
+            if (ws >= 0) close(ws);
+            ws = -1;
+          } else {
+            st.ok++;
+            first = false;
+          }
+        }
+      } else {
+        st.commands++;
+        char body[96];
+        int blen = snprintf(body, sizeof(body), "seq=%u&flags=%u&throttle=%u&dir=%u&steer=%d",
+                            seq, flags, in.throttle, in.dir, in.steer);
+        char req[256];
+        int len = snprintf(req, sizeof(req),
+                           "POST /control HTTP/1.1\r\nHost: car\r\n"
+                           "Content-Type: application/x-www-form-urlencoded\r\n"
+                           "Content-Length: %d\r\n\r\n%s", blen, body);
+        st.requests++;
+        int status = httpRequest(req, len, &seq32, st);
+        if (status == 200) {
+          st.ok++;
+          first = false;
+        } else if (status == 409) {
+          st.rejected++;
+        } else {
+          st.failed++;
+        }
+      }
+
+      // fixed rate; a client that fell behind doesn't try to catch up
+      next += periodUs;
+      int32_t wait = (int32_t)(next - nowUs());
+      if (wait > 0) usleep(wait);
+      else next = nowUs();
+    }
+    if (ws >= 0) close(ws);
+    clientsRunning--;
+  }
+
+  // page reloads: the page itself, then a control channel opened and dropped;
+  // with nobody driving there is no channel to reopen
+  void churnClient(const Config& cfg, ClientStats& st) {
+    countHeap = false;
+    uint32_t periodUs = (uint32_t)(1e6f / cfg.churnHz);
+    static const char page[] = "GET / HTTP/1.1\r\nHost: car\r\nAccept-Encoding: gzip\r\n\r\n";
+    while (!stopping) {
+      st.requests++;
+      int status = httpRequest(page, sizeof(page) - 1, nullptr, st);
+      if (status == 200) st.ok++;
+      else st.failed++;
+      if (cfg.clients > 0) {
+        int ws = openWebSocket();
+        if (ws >= 0) close(ws);
+        else if (ws == -2) st.refused++;
+      }
+      for (uint32_t slept = 0; slept < periodUs && !stopping; slept += 10000) usleep(10000);
+    }
+    clientsRunning--;
+  }
+
+  /* ---------------------------------------------------
+     Report
+  --------------------------------------------------- */
+
+  struct Percentiles {
+    size_t n = 0;
+    uint32_t p50 = 0, p95 = 0, p99 = 0, max = 0, mean = 0;
+  };
+
+  Percentiles percentiles(std::vector<uint32_t> v) {
+    Percentiles p;
+    p.n = v.size();
+    if (v.empty()) return p;
+    std::sort(v.begin(), v.end());
+    uint64_t sum = 0;
+    for (uint32_t x : v) sum += x;
+    p.p50 = v[v.size() * 50 / 100];
+    p.p95 = v[v.size() * 95 / 100];
+    p.p99 = v[v.size() * 99 / 100];
+    p.max = v.back();
+    p.mean = (uint32_t)(sum / v.size());
+    return p;
+  }
+
+  void printPercentiles(FILE* f, const char* name, const Percentiles& p, bool last = false) {
+    fprintf(f, "  \"%s\": {\"n\": %zu, \"p50\": %u, \"p95\": %u, \"p99\": %u, \"max\": %u, \"mean\": %u}%s\n",
+            name, p.n, p.p50, p.p95, p.p99, p.max, p.mean, last ? "" : ",");
+  }
+
+  const char* transportName(Transport t) { return t == HTTP ? "http" : "ws"; }
+  const char* patternName(Pattern p) { return p == SLIDER ? "slider" : "keys"; }
+}
+
+int main(int argc, char** argv) {
+  Config cfg;
+  for (int i = 1; i < argc; ++i) {
+    const char* arg = argv[i];
+    const char* val = i + 1 < argc ? argv[i + 1] : nullptr;
+    if (!val) {
+      usage(argv[0]);
+      return 2;
+    }
+    i++;
+    if (!strcmp(arg, "--scenario")) {
+      bool found = false;
+      for (const Preset& p : PRESETS) {
+        if (strcmp(p.name, val)) continue;
+        cfg.scenario = p.name;
+        cfg.clients = p.clients;
+        cfg.rateHz = p.rateHz;
+        cfg.transport = p.transport;
+        cfg.pattern = p.pattern;
+        cfg.churnHz = p.churnHz;
+        found = true;
+      }
+      if (!found) {
+        usage(argv[0]);
+        return 2;
+      }
+    } else if (!strcmp(arg, "--clients")) {
+      cfg.clients = atoi(val);
+    } else if (!strcmp(arg, "--rate")) {
+      cfg.rateHz = atof(val);
+    } else if (!strcmp(arg, "--transport")) {
+      cfg.transport = !strcmp(val, "ws") ? WEBSOCKET : HTTP;
+    } else if (!strcmp(arg, "--pattern")) {
+      cfg.pattern = !strcmp(val, "keys") ? KEYS : SLIDER;
+    } else if (!strcmp(arg, "--churn")) {
+      cfg.churnHz = atof(val);
+    } else if (!strcmp(arg, "--duration")) {
+      cfg.durationS = atof(val);
+    } else if (!strcmp(arg, "--json")) {
+      cfg.json = val;
+    } else if (!strcmp(arg, "--port-offset")) {
+      cfg.portOffset = (uint16_t)atoi(val);
+    } else if (!strcmp(arg, "--idle-us")) {
+      cfg.idleUs = strtoul(val, nullptr, 10);
+    } else {
+      usage(argv[0]);
+      return 2;
+    }
+  }
+  if ((cfg.clients == 0 && cfg.churnHz <= 0) || cfg.rateHz <= 0 || cfg.durationS <= 0 || cfg.churnHz < 0) {
+    usage(argv[0]);
+    return 2;
+  }
+
+  // the firmware, as in the simulator, minus its chatter
+  host::setSerialEcho(false);
+  host::setPortOffset(cfg.portOffset);
+  httpPort = 80 + cfg.portOffset;
+  Serial.begin(115200);
+  StateManager& state = StateManager::instance();
+  state.init(WIFI_SSID, WIFI_PASSWORD);
+
+  const Scheduler& sched = state.getScheduler();
+  uint8_t motorTask = 0;
+  while (motorTask < sched.taskCount() && strcmp(sched.task(motorTask).name, "motor") != 0) motorTask++;
+
+  // settle: link up, first display frames out of the way
+  uint32_t settle = nowUs();
+  while (nowUs() - settle < 300000) {
+    state.update(millis());
+    usleep(cfg.idleUs);
+  }
+  long heapBaseline = heapNow.load();
+  heapPeak = heapBaseline;
+  uint32_t writeCalls = host::clientWrites();
+  uint32_t writeBytes = host::clientBytesWritten();
+
+  std::vector<ClientStats> stats(cfg.clients + 1);
+  std::vector<std::thread> threads;
+  clientsRunning = cfg.clients + (cfg.churnHz > 0 ? 1 : 0);
+  for (unsigned i = 0; i < cfg.clients; ++i) {
+    threads.emplace_back(commandClient, std::cref(cfg), i, std::ref(stats[i]));
+  }
+  if (cfg.churnHz > 0) threads.emplace_back(churnClient, std::cref(cfg), std::ref(stats[cfg.clients]));
+
+  // the firmware loop, watching which command reaches the motors and when:
+  // a sequence is applied once it is the telemetry ack, actuated at the
+  // next motor task run
+  std::vector<uint32_t> actuationUs;
+  std::vector<uint16_t> applied;
+  uint32_t actuated = 0;
+  bool haveAck = false;
+  uint16_t lastAck = 0;
+  uint32_t motorRuns = sched.task(motorTask).runs;
+  uint32_t start = nowUs();
+  uint32_t durationUs = (uint32_t)(cfg.durationS * 1e6f);
+
+  while (clientsRunning > 0) {
+    if (!stopping && nowUs() - start >= durationUs) stopping = true;
+
+    host::stepWheels();
+    state.update(millis());
+
+    TelemetryFrame t;
+    state.fillTelemetry(t);
+    if (!haveAck || t.ackSeq != lastAck) {
+      haveAck = true;
+      lastAck = t.ackSeq;
+      applied.push_back(lastAck);
+    }
+    if (sched.task(motorTask).runs != motorRuns) {
+      motorRuns = sched.task(motorTask).runs;
+      uint32_t now = nowUs();
+      for (uint16_t seq : applied) {
+        uint32_t sent = sentUs[seq].exchange(0);
+        if (!sent) continue;
+        actuationUs.push_back(now - sent);
+        actuated++;
+      }
+      applied.clear();
+    }
+    if (cfg.idleUs > 0) usleep(cfg.idleUs);
+  }
+  for (std::thread& th : threads) th.join();
+  float elapsedS = (nowUs() - start) / 1e6f;
+  writeCalls = host::clientWrites() - writeCalls;
+  writeBytes = host::clientBytesWritten() - writeBytes;
+
+  ClientStats total;
+  std::vector<uint32_t> commandRequestUs;
+  for (unsigned i = 0; i <= cfg.clients; ++i) {
+    const ClientStats& s = stats[i];
+    total.requests += s.requests;
+    total.ok += s.ok;
+    total.rejected += s.rejected;
+    total.failed += s.failed;
+    total.refused += s.refused;
+    total.commands += s.commands;
+    if (i < cfg.clients) commandRequestUs.insert(commandRequestUs.end(), s.requestUs.begin(), s.requestUs.end());
+  }
+
+  FILE* f = cfg.json ? fopen(cfg.json, "w") : stdout;
+  if (!f) {
+    perror(cfg.json);
+    return 2;
+  }
+  const LatencyHistogram& pass = sched.getPassTimes();
+  fprintf(f, "{\n");
+  fprintf(f, "  \"scenario\": \"%s\",\n", cfg.scenario);
+  fprintf(f, "  \"config\": {\"clients\": %u, \"rate_hz\": %.1f, \"transport\": \"%s\", \"pattern\": \"%s\", "
+             "\"churn_hz\": %.2f, \"duration_s\": %.1f, \"idle_us\": %lu},\n",
+          cfg.clients, cfg.rateHz, transportName(cfg.transport), patternName(cfg.pattern),
+          cfg.churnHz, cfg.durationS, cfg.idleUs);
+  fprintf(f, "  \"elapsed_s\": %.3f,\n", elapsedS);
+  fprintf(f, "  \"requests\": {\"sent\": %u, \"ok\": %u, \"rejected\": %u, \"failed\": %u, \"per_s\": %.1f},\n",
+          total.requests, total.ok, total.rejected, total.failed, total.requests / elapsedS);
+  // WebSocket opens answered 503 (all control channels taken), not requests
+  fprintf(f, "  \"refused_connections\": %u,\n", total.refused);
+  // not actuated: stale, coalesced, or overtaken before the motor task ran;
+  // stale is the firmware's own count of frames refused as out of order
+  TelemetryFrame last;
+  state.fillTelemetry(last);
+  fprintf(f, "  \"commands\": {\"sent\": %u, \"actuated\": %u, \"dropped\": %u, \"stale\": %u},\n",
+          total.commands, actuated, total.commands - actuated, last.staleFrames);
+  if (cfg.transport == HTTP) printPercentiles(f, "request_us", percentiles(commandRequestUs));
+  printPercentiles(f, "actuation_us", percentiles(actuationUs));
+  if (cfg.churnHz > 0) printPercentiles(f, "page_us", percentiles(stats[cfg.clients].requestUs));
+  // every WiFiClient::write of the firmware, responses and WebSocket frames alike
+  fprintf(f, "  \"socket_writes\": {\"calls\": %u, \"bytes\": %u, \"bytes_per_call\": %.1f},\n",
+          writeCalls, writeBytes, writeCalls ? (float)writeBytes / writeCalls : 0.0f);
+  fprintf(f, "  \"heap\": {\"baseline_bytes\": %ld, \"peak_bytes\": %ld, \"peak_growth_bytes\": %ld},\n",
+          heapBaseline, heapPeak.load(), heapPeak.load() - heapBaseline);
+  fprintf(f, "  \"firmware\": {\"pass_p99_us\": %lu, \"pass_max_us\": %lu, \"pass_overruns\": %lu}\n",
+          (unsigned long)pass.percentile(99), (unsigned long)pass.maximum(),
+          (unsigned long)sched.getPassOverruns());
+  fprintf(f, "}\n");
+  if (cfg.json) fclose(f);
+  return 0;
+}
@@ -0,0 +1,68 @@
+// runs the sketch natively: setup() once, then loop() until Ctrl-C
+
+#include <Arduino.h>
+#include "HostHal.h"
+
+#include <signal.h>
+#include <unistd.h>
+
+void setup();
+void loop();
+
+namespace {
+  volatile sig_atomic_t running = 1;
+
+  void onSignal(int) {
+    running = 0;
+  }
+
+  void usage(const char* argv0) {
+    fprintf(stderr,
+            "usage: %s [--port-offset N] [--idle-us N] [--wheel-scale PCT]\n"
+            "  --port-offset N    added to firmware ports (default 8000: http 8080, udp 12210)\n"
+            "  --idle-us N        sleep between loop() passes (default 100)\n"
+            "  --wheel-scale PCT  simulated wheel speed per PWM, e.g. 70 for a sagging battery\n",
+            argv0);
+  }
+}
+
+int main(int argc, char** argv) {
+  unsigned long idleUs = 100;
+  uint8_t wheelScale = 100;
+
+  for (int i = 1; i < argc; ++i) {
+    if (!strcmp(argv[i], "--port-offset") && i + 1 < argc) {
+      host::setPortOffset((uint16_t)atoi(argv[++i]));
+    } else if (!strcmp(argv[i], "--idle-us") && i + 1 < argc) {
+      idleUs = strtoul(argv[++i], nullptr, 10);
+    } else if (!strcmp(argv[i], "--wheel-scale") && i + 1 < argc) {
+      int pct = atoi(argv[++i]);
+      wheelScale = (uint8_t)constrain(pct, 0, 255);
+    } else {
+      usage(argv[0]);
+      return 2;
+    }
+  }
+
+  signal(SIGINT, onSignal);
+  signal(SIGTERM, onSignal);
+  setvbuf(stdout, nullptr, _IOLBF, 0);
+
+  // both bridge channels turn a wheel with an encoder, wired as in MotorManager
+  host::WheelModel left;
+  left.en = 5; left.in1 = 2; left.in2 = 3; left.encoderPin = A1;
+  host::WheelModel right;
+  right.en = 9; right.in1 = 7; right.in2 = 8; right.encoderPin = A2;
+  left.scalePercent = right.scalePercent = wheelScale;
+  host::addWheel(left);
+  host::addWheel(right);
+
+  setup();
+  while (running) {
+    host::stepWheels();
+    loop();
+    // the target spins flat out; give the dev box its cpu back
+    if (idleUs > 0) usleep(idleUs);
+  }
+  return 0;
+}
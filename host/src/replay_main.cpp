@@ -0,0 +1,459 @@
+// feeds a flight recorder dump back through StateManager on a virtual clock
+// and compares the actuator timeline it produces with the captured one
+
+#include <Arduino.h>
+#include "HostHal.h"
+#include "StateManager.h"
+#include "FlightRecorder.h"
+#include "secret.h"
+
+#include <vector>
+#include <algorithm>
+
+namespace {
+  struct Event {
+    uint64_t us; // unwrapped micros()
+    FlightRecorder::Record rec;
+  };
+
+  struct Options {
+    const char* capture = nullptr;
+    const char* out = nullptr;
+    unsigned long stepUs = 100;
+    unsigned long tailMs = 1000;
+    uint8_t wheelScale = 100;
+    bool timeline = false;
+    bool log = false;
+    int tolerance = 2;
+  };
+
+  void usage(const char* argv0) {
+    fprintf(stderr,
+            "usage: %s CAPTURE [--out FILE] [--step-us N] [--tail-ms N] [--wheel-scale PCT] [--tolerance N] [--timeline] [--log]\n"
+            "  CAPTURE          dump from GET /recorder or the serial \"recorder\" command\n"
+            "  --out FILE       write the replay's own recorder dump there\n"
+            "  --step-us N      virtual time per loop pass (default 100)\n"
+            "  --tail-ms N      keep running after the last command (default 1000)\n"
+            "  --wheel-scale P  simulated wheel speed per PWM (default 100)\n"
+            "  --tolerance N    PWM / servo us two states may differ by (default 2)\n"
+            "  --timeline       print both actuator timelines side by side\n"
+            "  --log            show the firmware's log output\n",
+            argv0);
+  }
+
+  // commands; link changes are injected too but happen on the replay's own
+  // boot as well, so they don't count as inputs
+  bool isInput(uint8_t type) {
+    return type >= FlightRecorder::CMD_SPEED && type <= FlightRecorder::CMD_CONTROL;
+  }
+
+  // 32-bit timestamps made monotonic; consecutive records are never 35 min apart
+  void unwrap(std::vector<Event>& events) {
+    uint64_t base = 0;
+    for (size_t i = 0; i < events.size(); ++i) {
+      if (i == 0) {
+        base = events[i].rec.us;
+      } else {
+        base += (uint32_t)(events[i].rec.us - events[i - 1].rec.us);
+      }
+      events[i].us = base;
+    }
+  }
+
+  bool load(const char* path, std::vector<Event>& events, uint32_t& total) {
+    FILE* f = fopen(path, "rb");
+    if (!f) {
+      perror(path);
+      return false;
+    }
+    std::vector<uint8_t> buf;
+    uint8_t chunk[4096];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0) buf.insert(buf.end(), chunk, chunk + n);
+    fclose(f);
+
+    // a serial capture starts with the "recorder <n>" line
+    size_t start = 0;
+    if (buf.size() > 9 && memcmp(buf.data(), "recorder ", 9) == 0) {
+      while (start < buf.size() && buf[start] != '\n') start++;
+      start++;
+    }
+
+    uint16_t count;
+    if (start >= buf.size() || !FlightRecorder::parseHeader(buf.data() + start, buf.size() - start, count, total)) {
+      fprintf(stderr, "%s: not a flight recorder dump\n", path);
+      return false;
+    }
+    const uint8_t* p = buf.data() + start + FlightRecorder::HEADER_SIZE;
+    for (uint16_t i = 0; i < count; ++i, p += FlightRecorder::RECORD_SIZE) {
+      events.push_back({0, FlightRecorder::parseRecord(p)});
+    }
+    unwrap(events);
+    return true;
+  }
+
+  // a Print that collects into memory, for --out
+  class Buffer : public Print {
+    public:
+      std::vector<uint8_t> bytes;
+      size_t write(uint8_t c) override { bytes.push_back(c); return 1; }
+      size_t write(const uint8_t* buf, size_t len) override {
+        bytes.insert(bytes.end(), buf, buf + len);
+        return len;
+      }
+  };
+
+  StateManager* state;
+  uint64_t clockUs = 0; // virtual micros, unwrapped
+
+  void runUntil(uint64_t targetUs, unsigned long stepUs) {
+    while (clockUs < targetUs) {
+      host::stepWheels();
+      state->update(millis());
+      unsigned long step = (unsigned long)std::min<uint64_t>(stepUs, targetUs - clockUs);
+      host::advanceMicros(step);
+      clockUs += step;
+    }
+  }
+
+  // the car's pass started late: time moves on with no pass in between
+  void skip(unsigned long us) {
+    host::advanceMicros(us);
+    clockUs += us;
+  }
+
+  void inject(const FlightRecorder::Record& r) {
+    switch (r.type) {
+      case FlightRecorder::CMD_SPEED: state->cmd_setMotorSpeed((uint8_t)r.a); break;
+      case FlightRecorder::CMD_DIR: state->cmd_setMotorDir(r.a); break;
+      case FlightRecorder::CMD_STEER: state->cmd_setSteering(r.a); break;
+      case FlightRecorder::CMD_MODE: state->cmd_setDriveMode(r.a); break;
+      case FlightRecorder::CMD_TANK: state->cmd_setTank(r.a, r.b); break;
+      case FlightRecorder::CMD_HEARTBEAT: state->cmd_heartbeat(); break;
+      case FlightRecorder::CMD_ARM: state->cmd_arm(); break;
+      case FlightRecorder::CMD_CONTROL: {
+        ControlFrame frame;
+        frame.seq = r.seq;
+        frame.throttle = (uint8_t)r.a;
+        frame.direction = (uint8_t)r.b;
+        frame.steering = (int8_t)r.c;
+        frame.flags = (uint8_t)r.d;
+        state->cmd_applyControl(frame, (FlightRecorder::Source)r.source, (uint8_t)(r.d >> 8));
+        break;
+      }
+      case FlightRecorder::EVENT_LINK:
+        // noticed on the firmware's next link poll, not at this exact time
+        host::setLinkUp(r.a != 0);
+        break;
+    }
+  }
+
+  // time from each input to the first actuator change it caused
+  std::vector<uint64_t> latencies(const std::vector<Event>& events) {
+    std::vector<uint64_t> out;
+    for (size_t i = 0; i < events.size(); ++i) {
+      if (!isInput(events[i].rec.type)) continue;
+      for (size_t j = i + 1; j < events.size(); ++j) {
+        if (isInput(events[j].rec.type)) break;
+        if (events[j].rec.type == FlightRecorder::ACTUATORS) {
+          out.push_back(events[j].us - events[i].us);
+          break;
+        }
+      }
+    }
+    std::sort(out.begin(), out.end());
+    return out;
+  }
+
+  void printLatency(const char* name, const std::vector<uint64_t>& l) {
+    if (l.empty()) {
+      printf("latency.%s n=0\n", name);
+      return;
+    }
+    uint64_t sum = 0;
+    for (uint64_t v : l) sum += v;
+    printf("latency.%s n=%zu p50=%llu p99=%llu max=%llu mean=%llu\n", name, l.size(),
+           (unsigned long long)l[l.size() / 2], (unsigned long long)l[(l.size() * 99) / 100],
+           (unsigned long long)l.back(), (unsigned long long)(sum / l.size()));
+  }
+
+  std::vector<Event> actuators(const std::vector<Event>& events, uint64_t from) {
+    std::vector<Event> out;
+    for (const Event& e : events) {
+      if (e.rec.type == FlightRecorder::ACTUATORS && e.us >= from) out.push_back(e);
+    }
+    return out;
+  }
+
+  uint8_t findTask(const Scheduler& sched, const char* name) {
+    uint8_t i = 0;
+    while (i < sched.taskCount() && strcmp(sched.task(i).name, name) != 0) i++;
+    return i;
+  }
+
+  // when the cycle that drained a command was due on the car, unwrapped
+  uint64_t drainTickUs(const Event& drain) {
+    return drain.us - (uint16_t)drain.rec.a;
+  }
+
+  uint32_t drainSlot(const Event& drain) {
+    return (uint16_t)drain.rec.b | (uint32_t)(uint16_t)drain.rec.c << 16;
+  }
+
+  uint64_t gcd(uint64_t a, uint64_t b) {
+    while (b) {
+      uint64_t t = a % b;
+      a = b;
+      b = t;
+    }
+    return a;
+  }
+
+  // after this long every periodic task is back on the same phase
+  uint64_t schedulerCycle(const Scheduler& sched) {
+    uint64_t cycle = 1;
+    for (uint8_t i = 0; i < sched.taskCount(); ++i) {
+      uint32_t p = sched.task(i).periodUs;
+      if (p > 0) cycle = cycle / gcd(cycle, p) * p;
+    }
+    return cycle;
+  }
+
+  // largest difference in PWM or servo us; a failsafe state change never matches
+  int stateDiff(const FlightRecorder::Record& x, const FlightRecorder::Record& y) {
+    if (x.d != y.d) return 0x7FFF;
+    int diff = abs(x.a - y.a);
+    diff = std::max(diff, abs(x.b - y.b));
+    return std::max(diff, abs(x.c - y.c));
+  }
+}
+
+int main(int argc, char** argv) {
+  Options opt;
+  for (int i = 1; i < argc; ++i) {
+    if (!strcmp(argv[i], "--out") && i + 1 < argc) {
+      opt.out = argv[++i];
+    } else if (!strcmp(argv[i], "--step-us") && i + 1 < argc) {
+      opt.stepUs = strtoul(argv[++i], nullptr, 10);
+    } else if (!strcmp(argv[i], "--tail-ms") && i + 1 < argc) {
+      opt.tailMs = strtoul(argv[++i], nullptr, 10);
+    } else if (!strcmp(argv[i], "--wheel-scale") && i + 1 < argc) {
+      int pct = atoi(argv[++i]);
+      opt.wheelScale = (uint8_t)constrain(pct, 0, 255);
+    } else if (!strcmp(argv[i], "--tolerance") && i + 1 < argc) {
+      opt.tolerance = atoi(argv[++i]);
+    } else if (!strcmp(argv[i], "--timeline")) {
+      opt.timeline = true;
+    } else if (!strcmp(argv[i], "--log")) {
+      opt.log = true;
+    } else if (argv[i][0] != '-' && !opt.capture) {
+      opt.capture = argv[i];
+    } else {
+      usage(argv[0]);
+      return 2;
+    }
+  }
+  if (!opt.capture || opt.stepUs == 0) {
+    usage(argv[0]);
+    return 2;
+  }
+
+  std::vector<Event> captured;
+  uint32_t capturedTotal = 0;
+  if (!load(opt.capture, captured, capturedTotal)) return 2;
+
+  size_t firstInput = 0;
+  while (firstInput < captured.size() && !isInput(captured[firstInput].rec.type)) firstInput++;
+  if (firstInput == captured.size()) {
+    fprintf(stderr, "%s: no commands to replay\n", opt.capture);
+    return 2;
+  }
+  if (capturedTotal > captured.size()) {
+    fprintf(stderr, "note: the ring wrapped (%lu of %lu records kept); replay starts from boot state\n",
+            (unsigned long)captured.size(), (unsigned long)capturedTotal);
+  }
+
+  // same firmware, same wheels as the simulator, but nothing moves unless we say so
+  host::setSerialEcho(opt.log);
+  host::setPortOffset(20000); // stay clear of a simulator on the default ports
+  host::useVirtualClock(true);
+  host::WheelModel left;
+  left.en = 5; left.in1 = 2; left.in2 = 3; left.encoderPin = A1;
+  host::WheelModel right;
+  right.en = 9; right.in1 = 7; right.in2 = 8; right.encoderPin = A2;
+  left.scalePercent = right.scalePercent = opt.wheelScale;
+  host::addWheel(left);
+  host::addWheel(right);
+
+  Serial.begin(115200);
+  state = &StateManager::instance();
+  clockUs = micros();
+  state->init(WIFI_SSID, WIFI_PASSWORD);
+
+  // the replay's scheduler slots line up with the car's, read off a drain
+  // record: its tick minus that many commands periods is where the car's
+  // grid started. Every task started together, so this lines them all up
+  const Scheduler& sched = state->getScheduler();
+  uint8_t commandTask = findTask(sched, "commands");
+  const Event* drain = nullptr;
+  for (const Event& e : captured) {
+    if (e.rec.type == FlightRecorder::EVENT_DRAIN) {
+      drain = &e;
+      break;
+    }
+  }
+  int64_t offset = (int64_t)clockUs + 100000 - (int64_t)captured[firstInput].us;
+  if (drain && commandTask < sched.taskCount()) {
+    int64_t carStart = (int64_t)drainTickUs(*drain) - (int64_t)drainSlot(*drain) * sched.task(commandTask).periodUs;
+    int64_t cycle = (int64_t)schedulerCycle(sched);
+    int64_t aligned = (int64_t)sched.task(commandTask).nextDueUs - carStart;
+    // the same phase, no earlier than 100 ms after the replay's boot
+    offset = aligned + ((offset - aligned) / cycle + ((offset - aligned) % cycle > 0)) * cycle;
+  } else {
+    fprintf(stderr, "note: no drain records in the capture, commands apply on the replay's own control cycle\n");
+  }
+
+  // a command waits in the queue for the next drain; when the car's pass ran
+  // late it arrived after that drain's tick, so it goes in just before the
+  // tick here or the replay would apply it a cycle later. What came in the
+  // same pass ahead of it moves with it, order kept
+  std::vector<uint64_t> injectAt(captured.size());
+  uint64_t nextTick = UINT64_MAX;
+  for (size_t i = captured.size(); i-- > 0;) {
+    if (captured[i].rec.type == FlightRecorder::EVENT_DRAIN) nextTick = drainTickUs(captured[i]);
+    injectAt[i] = std::min(captured[i].us, nextTick) + offset;
+  }
+
+  runUntil(injectAt[firstInput], opt.stepUs);
+  uint32_t replayMark = state->getRecorder().total();
+
+  for (size_t i = firstInput; i < captured.size(); ++i) {
+    uint8_t type = captured[i].rec.type;
+    if (type == FlightRecorder::EVENT_DRAIN && drain) {
+      // and the drain's pass as late as on the car, so the motor's and the
+      // servo's first step toward what it applied is as long
+      runUntil(injectAt[i], opt.stepUs);
+      skip((uint16_t)captured[i].rec.a);
+    } else if (isInput(type) || type == FlightRecorder::EVENT_LINK) {
+      runUntil(injectAt[i], opt.stepUs);
+      inject(captured[i].rec);
+    }
+  }
+  runUntil(clockUs + opt.tailMs * 1000, opt.stepUs);
+
+  // what the replay recorded from the first command on
+  const FlightRecorder& rec = state->getRecorder();
+  uint32_t fresh = rec.total() - replayMark;
+  if (fresh > rec.count()) {
+    fprintf(stderr, "note: the replay's own ring wrapped, comparing its last %lu records\n", (unsigned long)rec.count());
+    fresh = rec.count();
+  }
+  std::vector<Event> replayed;
+  for (size_t i = rec.count() - fresh; i < rec.count(); ++i) replayed.push_back({0, rec.at(i)});
+  unwrap(replayed);
+
+  // both timelines relative to the car's first command
+  uint64_t capOrigin = captured[firstInput].us;
+  uint64_t repOrigin = capOrigin + offset;
+  std::vector<Event> capOut = actuators(captured, capOrigin);
+  std::vector<Event> repOut = actuators(replayed, repOrigin);
+
+  // paired in order; ramp values depend on where the car's motor passes
+  // fell, which only the car knows, so they may differ by a count or two,
+  // and one side may catch a ramp step the other went straight past. A
+  // record within tolerance of the other side's last paired state stands
+  // alone as an extra instead of shifting every pair after it
+  struct Row {
+    long cap; // index into capOut, -1 for none
+    long rep;
+  };
+  std::vector<Row> rows;
+  size_t ci = 0;
+  size_t ri = 0;
+  long lastCap = -1;
+  long lastRep = -1;
+  size_t exact = 0;
+  size_t close = 0;
+  size_t extra = 0;
+  size_t paired = 0;
+  size_t firstOff = SIZE_MAX;
+  int maxDiff = 0;
+  int64_t maxDt = 0;
+  int64_t sumDt = 0;
+  while (ci < capOut.size() || ri < repOut.size()) {
+    bool both = ci < capOut.size() && ri < repOut.size();
+    int diff = both ? stateDiff(capOut[ci].rec, repOut[ri].rec) : 0x7FFF;
+    if (diff > opt.tolerance && ri < repOut.size() && lastCap >= 0 &&
+        stateDiff(repOut[ri].rec, capOut[lastCap].rec) <= opt.tolerance) {
+      rows.push_back({-1, (long)ri++});
+      extra++;
+      continue;
+    }
+    if (diff > opt.tolerance && ci < capOut.size() && lastRep >= 0 &&
+        stateDiff(capOut[ci].rec, repOut[lastRep].rec) <= opt.tolerance) {
+      rows.push_back({(long)ci++, -1});
+      extra++;
+      continue;
+    }
+    if (!both) {
+      // one timeline went on with states the other never had
+      if (firstOff == SIZE_MAX) firstOff = rows.size();
+      rows.push_back({ci < capOut.size() ? (long)ci++ : -1, ri < repOut.size() ? (long)ri++ : -1});
+      continue;
+    }
+
+    if (diff == 0) exact++;
+    if (diff <= opt.tolerance) close++;
+    else if (firstOff == SIZE_MAX) firstOff = rows.size();
+    if (diff > maxDiff) maxDiff = diff;
+    int64_t dt = (int64_t)(repOut[ri].us - repOrigin) - (int64_t)(capOut[ci].us - capOrigin);
+    if (llabs(dt) > llabs(maxDt)) maxDt = dt;
+    sumDt += dt;
+    paired++;
+    lastCap = (long)ci;
+    lastRep = (long)ri;
+    rows.push_back({(long)ci++, (long)ri++});
+  }
+
+  if (opt.timeline) {
+    printf("# t_us relative to the first command: captured | replayed (left right servo failsafe)\n");
+    for (size_t i = 0; i < rows.size(); ++i) {
+      char a[64] = "-";
+      char b[64] = "-";
+      if (rows[i].cap >= 0) {
+        const Event& e = capOut[rows[i].cap];
+        snprintf(a, sizeof(a), "%8llu %4d %4d %4d %d", (unsigned long long)(e.us - capOrigin), e.rec.a, e.rec.b, e.rec.c, e.rec.d);
+      }
+      if (rows[i].rep >= 0) {
+        const Event& e = repOut[rows[i].rep];
+        snprintf(b, sizeof(b), "%8llu %4d %4d %4d %d", (unsigned long long)(e.us - repOrigin), e.rec.a, e.rec.b, e.rec.c, e.rec.d);
+      }
+      printf("%-36s | %-36s%s\n", a, b, i == firstOff ? "  <- diverges" : "");
+    }
+  }
+
+  size_t inputs = 0;
+  for (size_t i = firstInput; i < captured.size(); ++i) inputs += isInput(captured[i].rec.type);
+  printf("inputs %zu\n", inputs);
+  printf("actuators captured=%zu replayed=%zu identical=%zu within_tolerance=%zu extra=%zu max_diff=%d\n",
+         capOut.size(), repOut.size(), exact, close, extra, maxDiff);
+  printf("timing dt_us max=%lld mean=%lld\n", (long long)maxDt,
+         (long long)(paired ? sumDt / (int64_t)paired : 0));
+  printLatency("captured", latencies(captured));
+  printLatency("replayed", latencies(replayed));
+
+  if (opt.out) {
+    Buffer buf;
+    rec.dump(buf);
+    FILE* f = fopen(opt.out, "wb");
+    if (!f || fwrite(buf.bytes.data(), 1, buf.bytes.size(), f) != buf.bytes.size()) {
+      perror(opt.out);
+      return 2;
+    }
+    fclose(f);
+  }
+
+  bool reproduced = firstOff == SIZE_MAX;
+  printf("%s\n", reproduced ? "timeline reproduced" : "timeline diverges");
+  return reproduced ? 0 : 1;
+}
@@ -0,0 +1,190 @@
+// CommandQueue coalescing and barriers, then the TANK, STOP, FORWARD burst
+// through the whole firmware: the stop must end tank driving even though
+// a newer direction arrived in the same control cycle. Also the ControlFrame
+// sequence check, which is per control channel
+
+#include <Arduino.h>
+#include "HostHal.h"
+#include "StateManager.h"
+#include "CommandQueue.h"
+#include "DriveMixer.h"
+#include "secret.h"
+
+namespace {
+  int failures = 0;
+
+  void check(bool ok, const char* what, const char* file, int line) {
+    if (ok) return;
+    failures++;
+    fprintf(stderr, "%s:%d: CHECK(%s) failed\n", file, line, what);
+  }
+
+  #define CHECK(cond) check((cond), #cond, __FILE__, __LINE__)
+
+  typedef CommandQueue Q;
+
+  void testCoalescing() {
+    Q q;
+    Q::Command out[Q::SIZE];
+    q.post(Q::SPEED, 10);
+    q.post(Q::STEERING, 5);
+    q.post(Q::SPEED, 20);
+    q.post(Q::SPEED, 30);
+    uint8_t n = q.drain(out);
+    CHECK(n == 2);
+    CHECK(out[0].channel == Q::STEERING && out[0].a == 5);
+    CHECK(out[1].channel == Q::SPEED && out[1].a == 30);
+    CHECK(q.getCoalesced() == 2);
+    CHECK(q.depth() == 0);
+  }
+
+  void testStopIsABarrier() {
+    Q q;
+    Q::Command out[Q::SIZE];
+    q.post(Q::TANK, 200, 200);
+    q.post(Q::DIRECTION, Q::STOP_DIRECTION);
+    q.post(Q::DIRECTION, 0);
+    uint8_t n = q.drain(out);
+    CHECK(n == 3);
+    CHECK(out[0].channel == Q::TANK);
+    CHECK(out[1].channel == Q::DIRECTION && out[1].a == Q::STOP_DIRECTION);
+    CHECK(out[2].channel == Q::DIRECTION && out[2].a == 0);
+    CHECK(q.getCoalesced() == 0);
+  }
+
+  void testWindowsCoalesceSeparately() {
+    Q q;
+    Q::Command out[Q::SIZE];
+    q.post(Q::SPEED, 1);
+    q.post(Q::SPEED, 2);
+    q.post(Q::MODE, DriveMixer::TANK);
+    q.post(Q::MODE, DriveMixer::SERVO_ONLY);
+    q.post(Q::SPEED, 3);
+    q.post(Q::DRIVE, 100, Q::STOP_DIRECTION, 0);
+    q.post(Q::DRIVE, 120, 0, 0);
+    q.post(Q::DRIVE, 140, 0, 0);
+    uint8_t n = q.drain(out);
+    // SPEED 2 | MODE | MODE | SPEED 3, DRIVE stop | DRIVE 140
+    CHECK(n == 6);
+    CHECK(out[0].channel == Q::SPEED && out[0].a == 2);
+    CHECK(out[1].channel == Q::MODE && out[1].a == DriveMixer::TANK);
+    CHECK(out[2].channel == Q::MODE && out[2].a == DriveMixer::SERVO_ONLY);
+    CHECK(out[3].channel == Q::SPEED && out[3].a == 3);
+    CHECK(out[4].channel == Q::DRIVE && out[4].b == Q::STOP_DIRECTION);
+    CHECK(out[5].channel == Q::DRIVE && out[5].a == 140);
+    CHECK(q.getCoalesced() == 2);
+  }
+
+  void testInvalidateVoidsBarriers() {
+    Q q;
+    Q::Command out[Q::SIZE];
+    q.post(Q::MODE, DriveMixer::TANK);
+    q.post(Q::DIRECTION, Q::STOP_DIRECTION);
+    q.invalidate();
+    q.post(Q::SPEED, 7);
+    uint8_t n = q.drain(out);
+    CHECK(n == 1);
+    CHECK(out[0].channel == Q::SPEED);
+    CHECK(q.getDiscarded() == 2);
+  }
+
+  void testFullQueueDrainsWhole() {
+    Q q;
+    Q::Command out[Q::SIZE];
+    for (uint8_t i = 0; i < Q::SIZE; ++i) CHECK(q.post(Q::MODE, i % DriveMixer::MODE_COUNT));
+    CHECK(!q.post(Q::SPEED, 1));
+    CHECK(q.drain(out) == Q::SIZE);
+  }
+
+  // the firmware, driven directly on a virtual clock
+  void runFor(StateManager& state, unsigned long ms) {
+    for (unsigned long i = 0; i < ms * 10; ++i) {
+      state.update(millis());
+      host::advanceMicros(100);
+    }
+  }
+
+  void testTankStopForwardBurst() {
+    host::setSerialEcho(false);
+    host::setPortOffset(27000);
+    host::useVirtualClock(true);
+    Serial.begin(115200);
+    StateManager& state = StateManager::instance();
+    state.init(WIFI_SSID, WIFI_PASSWORD);
+    runFor(state, 50);
+
+    CHECK(state.cmd_setMotorSpeed(0));
+    CHECK(state.cmd_setDriveMode(DriveMixer::TANK));
+    runFor(state, 20);
+    CHECK(state.cmd_setTank(200, 200));
+    runFor(state, 300);
+    TelemetryFrame t;
+    state.fillTelemetry(t);
+    CHECK(t.left > 0 && t.right > 0);
+
+    // all three land in one 5 ms window; the stop ends tank driving, the
+    // forward after it has no throttle to drive with
+    CHECK(state.cmd_setTank(200, 200));
+    CHECK(state.cmd_setMotorDir(MotorManager::STOP));
+    CHECK(state.cmd_setMotorDir(MotorManager::FORWARD));
+    runFor(state, 300);
+    state.fillTelemetry(t);
+    printf("after TANK, STOP, FORWARD: left %d right %d dir %u\n", t.left, t.right, t.direction);
+    CHECK(t.direction == MotorManager::FORWARD);
+    CHECK(t.left == 0 && t.right == 0);
+  }
+
+  // a mode switch voided while queued leaves tank targets refused
+  void testVoidedModeSwitch() {
+    StateManager& state = StateManager::instance();
+    CHECK(state.cmd_setDriveMode(DriveMixer::SERVO_ONLY));
+    runFor(state, 20);
+    CHECK(!state.cmd_setTank(100, 100));
+
+    CHECK(state.cmd_setDriveMode(DriveMixer::TANK));
+    ControlFrame estop;
+    estop.flags = ControlFrame::FLAG_ESTOP | ControlFrame::FLAG_RESYNC;
+    CHECK(state.cmd_applyControl(estop));
+    CHECK(!state.cmd_setTank(100, 100));
+    runFor(state, 20);
+    TelemetryFrame t;
+    state.fillTelemetry(t);
+    CHECK(t.driveMode == DriveMixer::SERVO_ONLY);
+  }
+
+  // two pages count their frames apart; neither makes the other's stale
+  void testChannelsNumberApart() {
+    StateManager& state = StateManager::instance();
+    ControlFrame f;
+    f.direction = MotorManager::FORWARD;
+    f.flags = ControlFrame::FLAG_RESYNC;
+    f.seq = 500;
+    CHECK(state.cmd_applyControl(f, FlightRecorder::SOURCE_WEB, 0));
+    f.seq = 1;
+    CHECK(state.cmd_applyControl(f, FlightRecorder::SOURCE_WEB, 1));
+    f.flags = 0;
+    for (uint16_t i = 0; i < 20; ++i) {
+      f.seq = 501 + i;
+      CHECK(state.cmd_applyControl(f, FlightRecorder::SOURCE_WEB, 0));
+      f.seq = 2 + i;
+      CHECK(state.cmd_applyControl(f, FlightRecorder::SOURCE_WEB, 1));
+      runFor(state, 5);
+    }
+    // still stale within a channel
+    f.seq = 510;
+    CHECK(!state.cmd_applyControl(f, FlightRecorder::SOURCE_WEB, 0));
+    CHECK(!state.cmd_applyControl(f, FlightRecorder::SOURCE_WEB, StateManager::CONTROL_CHANNELS));
+  }
+}
+
+int main() {
+  testCoalescing();
+  testStopIsABarrier();
+  testWindowsCoalesceSeparately();
+  testInvalidateVoidsBarriers();
+  testFullQueueDrainsWhole();
+  testTankStopForwardBurst();
+  testVoidedModeSwitch();
+  testChannelsNumberApart();
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,119 @@
+// FlightRecorder: which actuator states a ramp leaves on record, the ring
+// wrapping, and a dump parsed back
+
+#include <Arduino.h>
+#include "FlightRecorder.h"
+
+#include <vector>
+
+namespace {
+  int failures = 0;
+
+  void check(bool ok, const char* what, const char* file, int line) {
+    if (ok) return;
+    failures++;
+    fprintf(stderr, "%s:%d: CHECK(%s) failed\n", file, line, what);
+  }
+
+  #define CHECK(cond) check((cond), #cond, __FILE__, __LINE__)
+
+  const int16_t SERVO_US = 1500;
+
+  // one motor tick: both sides at out, ramping unless they reached target
+  void tick(FlightRecorder& r, int16_t out, int16_t target) {
+    r.recordOutput(out, out, SERVO_US, 0, out != target, target, target);
+  }
+
+  std::vector<int16_t> recordedLeft(const FlightRecorder& r) {
+    std::vector<int16_t> out;
+    for (size_t i = 0; i < r.count(); ++i) {
+      if (r.at(i).type == FlightRecorder::ACTUATORS) out.push_back(r.at(i).a);
+    }
+    return out;
+  }
+
+  // start and end of a ramp, none of the steps between
+  void testRampStartAndEnd() {
+    static FlightRecorder r;
+    tick(r, 0, 0);
+    for (int16_t out = 10; out < 100; out += 10) tick(r, out, 100);
+    tick(r, 100, 100);
+    tick(r, 100, 100);
+    std::vector<int16_t> left = recordedLeft(r);
+    CHECK(left.size() == 3);
+    CHECK(left == std::vector<int16_t>({0, 10, 100}));
+  }
+
+  // a new target mid-ramp is on record with the step that follows it
+  void testRetargetMidRamp() {
+    static FlightRecorder r;
+    tick(r, 0, 0);
+    for (int16_t out = 10; out <= 50; out += 10) tick(r, out, 100);
+    for (int16_t out = 60; out < 200; out += 10) tick(r, out, 200);
+    for (int16_t out = 190; out > 120; out -= 10) tick(r, out, 120);
+    tick(r, 120, 120);
+    std::vector<int16_t> left = recordedLeft(r);
+    CHECK(left == std::vector<int16_t>({0, 10, 60, 190, 120}));
+  }
+
+  // anything else that changes is on record even mid-ramp
+  void testServoMidRamp() {
+    static FlightRecorder r;
+    tick(r, 0, 0);
+    tick(r, 10, 100);
+    r.recordOutput(20, 20, SERVO_US + 100, 0, true, 100, 100);
+    r.recordOutput(30, 30, SERVO_US + 100, 0, true, 100, 100);
+    CHECK(recordedLeft(r).size() == 3);
+  }
+
+  void testRingWraps() {
+    static FlightRecorder r;
+    const size_t n = FLIGHT_RECORDER_SIZE + 10;
+    for (size_t i = 0; i < n; ++i) r.record(FlightRecorder::CMD_SPEED, FlightRecorder::SOURCE_WEB, 0, (int16_t)i);
+    CHECK(r.count() == FLIGHT_RECORDER_SIZE);
+    CHECK(r.total() == n);
+    CHECK(r.at(0).a == 10);
+    CHECK(r.at(r.count() - 1).a == (int16_t)(n - 1));
+  }
+
+  class Capture : public Print {
+    public:
+      std::vector<uint8_t> bytes;
+      size_t write(uint8_t b) override {
+        bytes.push_back(b);
+        return 1;
+      }
+      size_t write(const uint8_t* buf, size_t len) override {
+        bytes.insert(bytes.end(), buf, buf + len);
+        return len;
+      }
+  };
+
+  void testDumpParsesBack() {
+    static FlightRecorder r;
+    r.record(FlightRecorder::CMD_CONTROL, FlightRecorder::SOURCE_UDP, 4321, 200, 1, -40, 1 | 3 << 8);
+    tick(r, -255, -255);
+    Capture out;
+    CHECK(r.dump(out) == r.dumpSize());
+    CHECK(out.bytes.size() == r.dumpSize());
+
+    uint16_t count = 0;
+    uint32_t total = 0;
+    CHECK(FlightRecorder::parseHeader(out.bytes.data(), out.bytes.size(), count, total));
+    CHECK(count == 2 && total == 2);
+    FlightRecorder::Record c = FlightRecorder::parseRecord(out.bytes.data() + FlightRecorder::HEADER_SIZE);
+    CHECK(c.type == FlightRecorder::CMD_CONTROL && c.source == FlightRecorder::SOURCE_UDP);
+    CHECK(c.seq == 4321 && c.a == 200 && c.b == 1 && c.c == -40 && c.d == (1 | 3 << 8));
+    FlightRecorder::Record a = FlightRecorder::parseRecord(out.bytes.data() + FlightRecorder::HEADER_SIZE + FlightRecorder::RECORD_SIZE);
+    CHECK(a.type == FlightRecorder::ACTUATORS && a.a == -255 && a.c == SERVO_US);
+  }
+}
+
+int main() {
+  testRampStartAndEnd();
+  testRetargetMidRamp();
+  testServoMidRamp();
+  testRingWraps();
+  testDumpParsesBack();
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,239 @@
+// fuzz driver of HttpRequestParser: mutated requests and random bytes, fed in
+// random chunks, with the parser's invariants checked after every input.
+//   http_parser_fuzz [iterations] [seed]
+// Built with -DRC_LIBFUZZER and -fsanitize=fuzzer it is a libFuzzer target
+// instead, using the same checks.
+
+#include <Arduino.h>
+#include "HttpRequestParser.h"
+
+#include <random>
+#include <vector>
+
+namespace {
+  const char* seeds[] = {
+    "GET / HTTP/1.1\r\nHost: 192.168.4.1\r\n\r\n",
+    "GET /status HTTP/1.1\r\nAccept: */*\r\n\r\n",
+    "GET /setServoAngle?angle=90 HTTP/1.0\r\n\r\n",
+    "POST /control HTTP/1.1\r\nContent-Type: application/x-www-form-urlencoded\r\n"
+      "Content-Length: 40\r\n\r\nseq=12&flags=0&throttle=200&dir=1&steer=",
+    "POST /setMotorOutput?value=1 HTTP/1.1\r\nContent-Length: 9\r\n\r\nvalue=%32",
+    "POST /drive HTTP/1.1\r\nContent-Length: 22\r\n\r\nleft=-255&right=255&m=",
+  };
+
+  // pieces that sit on the parser's edges
+  const char* tokens[] = {
+    "\r\n", "\n", "\r", " ", ":", "?", "&", "=", "%", "%4", "%zz", "+", "/",
+    "HTTP/1.", "HTTP/1.1", "Content-Length: ", "content-length:", "0", "1024",
+    "99999999999999999999", "-1", "\r\n\r\n", "GET ", "POST ",
+  };
+
+  struct Outcome {
+    bool complete = false;
+    bool failed = false;
+    int status = 0;
+    size_t consumed = 0;
+    std::string method, path, query, body;
+  };
+
+  void die(const char* what, const std::vector<uint8_t>& input) {
+    fprintf(stderr, "invariant failed: %s\ninput (%zu bytes):\n", what, input.size());
+    fwrite(input.data(), 1, input.size(), stderr);
+    fprintf(stderr, "\n");
+    abort();
+  }
+
+  #define REQUIRE(cond) do { if (!(cond)) die(#cond, input); } while (0)
+
+  bool inside(const HttpRequestParser& p, StrView v) {
+    if (v.len == 0) return true;
+    const char* lo = (const char*)&p;
+    const char* hi = lo + sizeof(p);
+    return v.data >= lo && v.data + v.len <= hi;
+  }
+
+  std::string str(StrView v) {
+    return std::string(v.data ? v.data : "", v.len);
+  }
+
+  // feeds the input in chunks ending at the cut points; no cuts is one shot
+  Outcome run(HttpRequestParser& p, const std::vector<uint8_t>& input, const std::vector<size_t>& cuts) {
+    Outcome o;
+    size_t at = 0;
+    for (size_t i = 0; i <= cuts.size(); ++i) {
+      size_t end = i < cuts.size() ? cuts[i] : input.size();
+      size_t n = end - at;
+      size_t used = p.feed(input.data() + at, n);
+      REQUIRE(used <= n);
+      o.consumed += used;
+      // a partial read only happens once the request is over
+      REQUIRE(used == n || p.isComplete() || p.hasFailed());
+      at = end;
+    }
+
+    o.complete = p.isComplete();
+    o.failed = p.hasFailed();
+    o.status = p.errorStatus();
+    REQUIRE(!(o.complete && o.failed));
+    REQUIRE(o.consumed <= input.size());
+
+    if (o.failed) {
+      REQUIRE(o.status == 400 || o.status == 413 || o.status == 414 || o.status == 431);
+      REQUIRE(p.feed(input.data(), input.size()) == 0);
+    } else {
+      REQUIRE(o.status == 0);
+    }
+
+    if (o.complete) {
+      REQUIRE(!p.method().empty());
+      REQUIRE(p.path().len > 0 && p.path().data[0] == '/');
+      REQUIRE(p.body().len <= HttpRequestParser::BUFFER_SIZE);
+      REQUIRE(p.feed(input.data(), input.size()) == 0);
+    }
+
+    REQUIRE(inside(p, p.method()));
+    REQUIRE(inside(p, p.path()));
+    REQUIRE(inside(p, p.query()));
+    REQUIRE(inside(p, p.body()));
+    REQUIRE(inside(p, p.header("Content-Length")));
+    REQUIRE(inside(p, p.header("Host")));
+
+    // decoding stays inside the caller's buffer, however small
+    const char* names[] = { "seq", "throttle", "value", "angle", "m", "" };
+    for (const char* name : names) {
+      char out[20];
+      for (size_t size = 0; size <= 16; size += 4) {
+        memset(out, 0x5A, sizeof(out));
+        bool found = p.param(name, out, size);
+        for (size_t k = size; k < sizeof(out); ++k) REQUIRE(out[k] == 0x5A);
+        if (found) REQUIRE(size > 0 && strlen(out) < size);
+      }
+      long v;
+      p.paramInt(name, v);
+    }
+
+    o.method = str(p.method());
+    o.path = str(p.path());
+    o.query = str(p.query());
+    o.body = str(p.body());
+    return o;
+  }
+
+  // one input: the outcome may not depend on how the bytes were split
+  void checkOne(const std::vector<uint8_t>& input, std::mt19937& rng) {
+    HttpRequestParser oneShot;
+    Outcome a = run(oneShot, input, {});
+
+    std::vector<size_t> cuts;
+    for (size_t at = 0; at < input.size();) {
+      at += 1 + rng() % 64;
+      if (at < input.size()) cuts.push_back(at);
+    }
+    HttpRequestParser chunked;
+    Outcome b = run(chunked, input, cuts);
+
+    REQUIRE(a.complete == b.complete);
+    REQUIRE(a.failed == b.failed);
+    REQUIRE(a.status == b.status);
+    REQUIRE(a.consumed == b.consumed);
+    REQUIRE(a.method == b.method);
+    REQUIRE(a.path == b.path);
+    REQUIRE(a.query == b.query);
+    REQUIRE(a.body == b.body);
+
+    // reset() gives the same parser as a new one
+    chunked.reset();
+    Outcome c = run(chunked, input, {});
+    REQUIRE(c.complete == a.complete && c.status == a.status && c.consumed == a.consumed);
+  }
+
+  std::vector<uint8_t> mutate(std::mt19937& rng) {
+    const char* seed = seeds[rng() % (sizeof(seeds) / sizeof(seeds[0]))];
+    std::vector<uint8_t> in(seed, seed + strlen(seed));
+
+    // pure noise now and then
+    if (rng() % 16 == 0) {
+      in.resize(rng() % 2048);
+      for (uint8_t& b : in) b = (uint8_t)rng();
+      return in;
+    }
+
+    int edits = 1 + rng() % 8;
+    for (int e = 0; e < edits; ++e) {
+      size_t at = in.empty() ? 0 : rng() % (in.size() + 1);
+      switch (rng() % 6) {
+        case 0: // flip a byte
+          if (at < in.size()) in[at] = (uint8_t)rng();
+          break;
+        case 1: // drop a run
+          if (at < in.size()) in.erase(in.begin() + at, in.begin() + std::min(in.size(), at + 1 + rng() % 16));
+          break;
+        case 2: { // splice in an edge token
+          const char* t = tokens[rng() % (sizeof(tokens) / sizeof(tokens[0]))];
+          in.insert(in.begin() + at, t, t + strlen(t));
+          break;
+        }
+        case 3: { // a long run, around the line and buffer limits
+          size_t n = rng() % 2 ? HttpRequestParser::MAX_LINE - 8 + rng() % 16 : rng() % 1200;
+          in.insert(in.begin() + at, n, (uint8_t)('a' + rng() % 26));
+          break;
+        }
+        case 4: { // duplicate a slice, e.g. a header line
+          if (in.empty()) break;
+          size_t from = rng() % in.size();
+          size_t n = std::min(in.size() - from, (size_t)(1 + rng() % 48));
+          std::vector<uint8_t> slice(in.begin() + from, in.begin() + from + n);
+          in.insert(in.begin() + at, slice.begin(), slice.end());
+          break;
+        }
+        default: // truncate
+          in.resize(at);
+          break;
+      }
+    }
+    return in;
+  }
+}
+
+#ifdef RC_LIBFUZZER
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+  static std::mt19937 rng(1);
+  checkOne(std::vector<uint8_t>(data, data + size), rng);
+  return 0;
+}
+
+#else
+
+int main(int argc, char** argv) {
+  unsigned long iterations = argc > 1 ? strtoul(argv[1], nullptr, 10) : 20000;
+  unsigned long seed = argc > 2 ? strtoul(argv[2], nullptr, 10) : 1;
+
+  std::mt19937 rng(seed);
+  unsigned long complete = 0, failed = 0;
+  unsigned long byStatus[4] = {};
+
+  for (unsigned long i = 0; i < iterations; ++i) {
+    std::vector<uint8_t> input = mutate(rng);
+    checkOne(input, rng);
+
+    HttpRequestParser p;
+    p.feed(input.data(), input.size());
+    if (p.isComplete()) complete++;
+    if (p.hasFailed()) {
+      failed++;
+      switch (p.errorStatus()) {
+        case 400: byStatus[0]++; break;
+        case 413: byStatus[1]++; break;
+        case 414: byStatus[2]++; break;
+        default: byStatus[3]++; break;
+      }
+    }
+  }
+
+  printf("%lu inputs (seed %lu): %lu complete, %lu failed (400 %lu, 413 %lu, 414 %lu, 431 %lu), rest incomplete\n",
+         iterations, seed, complete, failed, byStatus[0], byStatus[1], byStatus[2], byStatus[3]);
+  return 0;
+}
+
+#endif
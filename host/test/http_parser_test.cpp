@@ -0,0 +1,365 @@
+// unit tests of HttpRequestParser: limits, malformed input, split reads and
+// allocations. Prints every failed check, exits non-zero if there was one.
+
+#include <Arduino.h>
+#include "HttpRequestParser.h"
+
+#include <new>
+
+namespace {
+  int failures = 0;
+  int checks = 0;
+
+  // counts operator new while armed; the parser must never get here
+  bool countAllocs = false;
+  size_t allocs = 0;
+
+  void check(bool ok, const char* what, const char* file, int line) {
+    checks++;
+    if (ok) return;
+    failures++;
+    fprintf(stderr, "%s:%d: CHECK(%s) failed\n", file, line, what);
+  }
+
+  #define CHECK(cond) check((cond), #cond, __FILE__, __LINE__)
+
+  bool viewIs(StrView v, const char* s) {
+    return v.equals(s);
+  }
+
+  size_t feedString(HttpRequestParser& p, const char* s) {
+    return p.feed((const uint8_t*)s, strlen(s));
+  }
+
+  // feeds text in chunks of `step` bytes, as a slow client would
+  size_t feedChunks(HttpRequestParser& p, const char* s, size_t step) {
+    size_t len = strlen(s);
+    size_t total = 0;
+    for (size_t at = 0; at < len; at += step) {
+      size_t n = (len - at < step) ? len - at : step;
+      total += p.feed((const uint8_t*)s + at, n);
+    }
+    return total;
+  }
+
+  std::string repeat(char c, size_t n) {
+    return std::string(n, c);
+  }
+
+  /* ---------------------------------------------------
+     well formed requests
+  --------------------------------------------------- */
+
+  void testSimpleGet() {
+    HttpRequestParser p;
+    CHECK(!p.isStarted());
+    const char* req = "GET /status HTTP/1.1\r\nHost: car\r\n\r\n";
+    CHECK(feedString(p, req) == strlen(req));
+    CHECK(p.isStarted());
+    CHECK(p.isComplete());
+    CHECK(!p.hasFailed());
+    CHECK(viewIs(p.method(), "GET"));
+    CHECK(viewIs(p.path(), "/status"));
+    CHECK(p.query().empty());
+    CHECK(p.body().empty());
+    CHECK(viewIs(p.header("host"), "car"));
+    CHECK(p.header("Content-Type").empty());
+  }
+
+  void testPostForm() {
+    HttpRequestParser p;
+    const char* req =
+      "POST /control HTTP/1.1\r\n"
+      "Content-Type: application/x-www-form-urlencoded\r\n"
+      "Content-Length: 27\r\n"
+      "\r\n"
+      "throttle=200&dir=1&steer=-5";
+    CHECK(feedString(p, req) == strlen(req));
+    CHECK(p.isComplete());
+    CHECK(viewIs(p.method(), "POST"));
+    CHECK(viewIs(p.path(), "/control"));
+    CHECK(viewIs(p.body(), "throttle=200&dir=1&steer=-5"));
+    CHECK(viewIs(p.header("content-length"), "27"));
+
+    long v = 0;
+    CHECK(p.paramInt("throttle", v) && v == 200);
+    CHECK(p.paramInt("dir", v) && v == 1);
+    CHECK(p.paramInt("steer", v) && v == -5);
+    CHECK(!p.paramInt("thr", v));
+    CHECK(!p.paramInt("missing", v));
+  }
+
+  void testQueryAndDecoding() {
+    HttpRequestParser p;
+    feedString(p, "GET /setServoAngle?angle=90&name=a%20b+c%2x&empty=&bad=9x HTTP/1.0\r\n\r\n");
+    CHECK(p.isComplete());
+    CHECK(viewIs(p.path(), "/setServoAngle"));
+    CHECK(viewIs(p.query(), "angle=90&name=a%20b+c%2x&empty=&bad=9x"));
+
+    char out[16];
+    CHECK(p.param("name", out, sizeof(out)) && !strcmp(out, "a b c%2x"));
+    CHECK(p.param("empty", out, sizeof(out)) && out[0] == '\0');
+
+    long v = 0;
+    CHECK(p.paramInt("angle", v) && v == 90);
+    CHECK(!p.paramInt("empty", v));
+    CHECK(!p.paramInt("bad", v));
+
+    // too small for the decoded value: refused, never truncated
+    char small[4];
+    CHECK(!p.param("name", small, sizeof(small)));
+    CHECK(!p.param("name", small, 0));
+  }
+
+  void testBodyWinsOverQuery() {
+    HttpRequestParser p;
+    feedString(p, "POST /setMotorOutput?value=1 HTTP/1.1\r\nContent-Length: 9\r\n\r\nvalue=200");
+    long v = 0;
+    CHECK(p.isComplete());
+    CHECK(p.paramInt("value", v) && v == 200);
+  }
+
+  void testLeadingBlankLinesAndBareLf() {
+    HttpRequestParser p;
+    feedString(p, "\r\n\nGET / HTTP/1.1\nX-A:  spaced \t\n\n");
+    CHECK(p.isComplete());
+    CHECK(viewIs(p.path(), "/"));
+    CHECK(viewIs(p.header("x-a"), "spaced"));
+  }
+
+  void testStopsAtEndOfRequest() {
+    // a pipelined second request is left for the caller
+    HttpRequestParser p;
+    const char* first = "POST /a HTTP/1.1\r\nContent-Length: 2\r\n\r\nokGET /b HTTP/1.1\r\n\r\n";
+    size_t n = feedString(p, first);
+    CHECK(p.isComplete());
+    CHECK(n == strlen(first) - strlen("GET /b HTTP/1.1\r\n\r\n"));
+    CHECK(viewIs(p.body(), "ok"));
+    CHECK(p.feed((const uint8_t*)"x", 1) == 0);
+
+    p.reset();
+    CHECK(!p.isStarted());
+    feedString(p, "GET /b HTTP/1.1\r\n\r\n");
+    CHECK(p.isComplete());
+    CHECK(viewIs(p.path(), "/b"));
+  }
+
+  void testExtraHeadersIgnored() {
+    std::string req = "GET / HTTP/1.1\r\n";
+    for (int i = 0; i < HttpRequestParser::MAX_HEADERS + 4; ++i) {
+      req += "H" + std::to_string(i) + ": v\r\n";
+    }
+    req += "\r\n";
+    HttpRequestParser p;
+    feedString(p, req.c_str());
+    CHECK(p.isComplete());
+    CHECK(viewIs(p.header("H0"), "v"));
+    CHECK(p.header("H19").empty());
+  }
+
+  /* ---------------------------------------------------
+     split reads
+  --------------------------------------------------- */
+
+  void testSplitReads() {
+    const char* req =
+      "POST /control?x=1 HTTP/1.1\r\n"
+      "Host: car\r\n"
+      "Content-Length: 18\r\n"
+      "\r\n"
+      "throttle=80&dir=2x";
+    size_t len = strlen(req);
+
+    // one byte per read
+    HttpRequestParser bytes;
+    CHECK(feedChunks(bytes, req, 1) == len);
+    CHECK(bytes.isComplete());
+    CHECK(viewIs(bytes.body(), "throttle=80&dir=2x"));
+
+    // every split point in two reads, CR and LF separated included
+    for (size_t at = 1; at < len; ++at) {
+      HttpRequestParser p;
+      size_t n = p.feed((const uint8_t*)req, at);
+      CHECK(!p.isComplete());
+      n += p.feed((const uint8_t*)req + at, len - at);
+      CHECK(n == len);
+      CHECK(p.isComplete());
+      CHECK(viewIs(p.method(), "POST"));
+      CHECK(viewIs(p.path(), "/control"));
+      CHECK(viewIs(p.query(), "x=1"));
+      CHECK(viewIs(p.header("host"), "car"));
+      CHECK(viewIs(p.body(), "throttle=80&dir=2x"));
+    }
+  }
+
+  void testSplitFailureMatchesOneShot() {
+    std::string req = "GET /" + repeat('a', HttpRequestParser::MAX_LINE) + " HTTP/1.1\r\n\r\n";
+    for (size_t step = 1; step <= 64; step *= 2) {
+      HttpRequestParser p;
+      feedChunks(p, req.c_str(), step);
+      CHECK(p.hasFailed());
+      CHECK(p.errorStatus() == 414);
+    }
+  }
+
+  /* ---------------------------------------------------
+     limits
+  --------------------------------------------------- */
+
+  void testLongRequestLine() {
+    // the longest accepted line is MAX_LINE characters, CRLF not counted
+    std::string prefix = "GET /";
+    std::string suffix = " HTTP/1.1";
+    size_t fill = HttpRequestParser::MAX_LINE - prefix.size() - suffix.size();
+
+    HttpRequestParser ok;
+    feedString(ok, (prefix + repeat('a', fill) + suffix + "\r\n\r\n").c_str());
+    CHECK(ok.isComplete());
+
+    HttpRequestParser p;
+    std::string req = prefix + repeat('a', fill + 1) + suffix + "\r\n\r\n";
+    size_t n = feedString(p, req.c_str());
+    CHECK(p.hasFailed());
+    CHECK(p.errorStatus() == 414);
+    CHECK(n == HttpRequestParser::MAX_LINE);
+    CHECK(p.feed((const uint8_t*)"\n", 1) == 0);
+  }
+
+  void testLongHeaderLine() {
+    HttpRequestParser p;
+    std::string req = "GET / HTTP/1.1\r\nX-Big: " + repeat('b', HttpRequestParser::MAX_LINE) + "\r\n\r\n";
+    feedString(p, req.c_str());
+    CHECK(p.hasFailed());
+    CHECK(p.errorStatus() == 431);
+  }
+
+  void testHeadersOverflowBuffer() {
+    // every line is short, together they outgrow the buffer
+    std::string req = "GET / HTTP/1.1\r\n";
+    for (int i = 0; i < 40; ++i) req += "X-Pad: " + repeat('p', 40) + "\r\n";
+    req += "\r\n";
+    HttpRequestParser p;
+    size_t n = feedString(p, req.c_str());
+    CHECK(p.hasFailed());
+    CHECK(p.errorStatus() == 431);
+    CHECK(n < req.size());
+  }
+
+  void testBodyTooLarge() {
+    HttpRequestParser p;
+    feedString(p, "POST /control HTTP/1.1\r\nContent-Length: 1024\r\n\r\n");
+    CHECK(p.hasFailed());
+    CHECK(p.errorStatus() == 413);
+
+    // huge values stop before they overflow size_t
+    HttpRequestParser huge;
+    feedString(huge, "POST / HTTP/1.1\r\nContent-Length: 99999999999999999999999\r\n\r\n");
+    CHECK(huge.hasFailed());
+    CHECK(huge.errorStatus() == 413);
+
+    // exactly what is left of the buffer still fits
+    const char* head = "POST / HTTP/1.1\r\nContent-Length: 990\r\n\r\n";
+    // stored: request line and header line without CR/LF
+    size_t stored = strlen("POST / HTTP/1.1") + strlen("Content-Length: 990");
+    size_t room = HttpRequestParser::BUFFER_SIZE - stored;
+    CHECK(room == 990);
+    HttpRequestParser fits;
+    feedString(fits, head);
+    std::string body = repeat('z', room);
+    CHECK(feedString(fits, body.c_str()) == room);
+    CHECK(fits.isComplete());
+    CHECK(fits.body().len == room);
+  }
+
+  /* ---------------------------------------------------
+     malformed input
+  --------------------------------------------------- */
+
+  void expect400(const char* req) {
+    HttpRequestParser p;
+    feedString(p, req);
+    bool ok = p.hasFailed() && p.errorStatus() == 400;
+    if (!ok) fprintf(stderr, "  expected 400 for: %s\n", req);
+    CHECK(ok);
+  }
+
+  void testMalformed() {
+    expect400("GET\r\n\r\n");
+    expect400("GET /\r\n\r\n");
+    expect400("GET / HTTP/2.0\r\n\r\n");
+    expect400("GET / HTTP/1.\r\n\r\n");
+    expect400(" / HTTP/1.1\r\n\r\n");
+    expect400("GET  HTTP/1.1\r\n\r\n");
+    expect400("GET status HTTP/1.1\r\n\r\n");
+    expect400("GET / HTTP/1.1\r\nNoColon\r\n\r\n");
+    expect400("GET / HTTP/1.1\r\n: empty-name\r\n\r\n");
+    expect400("POST / HTTP/1.1\r\nContent-Length: 12a\r\n\r\n");
+    expect400("POST / HTTP/1.1\r\nContent-Length: -1\r\n\r\n");
+    expect400("POST / HTTP/1.1\r\nContent-Length:\r\n\r\n");
+  }
+
+  /* ---------------------------------------------------
+     allocations
+  --------------------------------------------------- */
+
+  void testNoAllocations() {
+    const char* req =
+      "POST /control?seq=3 HTTP/1.1\r\n"
+      "Host: 192.168.4.1\r\n"
+      "Content-Type: application/x-www-form-urlencoded\r\n"
+      "Content-Length: 38\r\n"
+      "\r\n"
+      "seq=4&flags=0&throttle=200&dir=1&steer";
+
+    HttpRequestParser p;
+    allocs = 0;
+    countAllocs = true;
+    feedChunks(p, req, 7);
+    long v = 0;
+    char out[16];
+    bool found = p.paramInt("throttle", v) && p.param("seq", out, sizeof(out));
+    p.header("content-type");
+    p.reset();
+    feedString(p, "GET /status HTTP/1.1\r\n\r\n");
+    countAllocs = false;
+
+    CHECK(found && v == 200 && !strcmp(out, "4"));
+    CHECK(allocs == 0);
+  }
+}
+
+void* operator new(size_t n) {
+  if (countAllocs) allocs++;
+  void* p = malloc(n ? n : 1);
+  if (!p) throw std::bad_alloc();
+  return p;
+}
+
+void operator delete(void* p) noexcept {
+  free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+  free(p);
+}
+
+int main() {
+  testSimpleGet();
+  testPostForm();
+  testQueryAndDecoding();
+  testBodyWinsOverQuery();
+  testLeadingBlankLinesAndBareLf();
+  testStopsAtEndOfRequest();
+  testExtraHeadersIgnored();
+  testSplitReads();
+  testSplitFailureMatchesOneShot();
+  testLongRequestLine();
+  testLongHeaderLine();
+  testHeadersOverflowBuffer();
+  testBodyTooLarge();
+  testMalformed();
+  testNoAllocations();
+
+  printf("%d checks, %d failed\n", checks, failures);
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,87 @@
+// runs the firmware on a virtual clock through a link loss and back, with a
+// modem that takes a while to join, and checks that no loop pass waits on
+// the join, that the hardware watchdog (when built in) never bites, and
+// that the car comes back online
+
+#include <Arduino.h>
+#include "HostHal.h"
+#include "StateManager.h"
+#include "secret.h"
+
+namespace {
+  int failures = 0;
+
+  void check(bool ok, const char* what, const char* file, int line) {
+    if (ok) return;
+    failures++;
+    fprintf(stderr, "%s:%d: CHECK(%s) failed\n", file, line, what);
+  }
+
+  #define CHECK(cond) check((cond), #cond, __FILE__, __LINE__)
+
+  const unsigned long JOIN_MS = 1500;
+  const unsigned long LOSS_AT_MS = 3000;
+  const unsigned long BACK_AT_MS = 9000;
+  const unsigned long END_MS = 16000;
+  const unsigned long STEP_US = 1000;
+}
+
+int main() {
+  host::setSerialEcho(false);
+  host::setPortOffset(26000);
+  host::useVirtualClock(true);
+  host::setJoinDelay(JOIN_MS);
+
+  Serial.begin(115200);
+  StateManager& state = StateManager::instance();
+  unsigned long boot = millis();
+  state.init(WIFI_SSID, WIFI_PASSWORD);
+  unsigned long initMs = millis() - boot;
+
+  unsigned long longestPassMs = 0;
+  unsigned long upAt = 0, downAt = 0, backAt = 0;
+  bool wasUp = false;
+
+  while (millis() - boot < END_MS) {
+    unsigned long t = millis() - boot;
+    host::setLinkUp(t < LOSS_AT_MS || t >= BACK_AT_MS);
+
+    unsigned long before = millis();
+    state.update(before);
+    unsigned long pass = millis() - before;
+    if (pass > longestPassMs) longestPassMs = pass;
+
+    TelemetryFrame tf;
+    state.fillTelemetry(tf);
+    bool up = tf.flags & TelemetryFrame::FLAG_WIFI_UP;
+    if (up && !wasUp) {
+      if (!upAt) upAt = t;
+      else if (!backAt) backAt = t;
+    }
+    if (!up && wasUp && !downAt) downAt = t;
+    wasUp = up;
+
+    host::advanceMicros(STEP_US);
+  }
+
+  printf("init %lu ms, longest pass %lu ms, up at %lu, down at %lu, back at %lu\n",
+         initMs, longestPassMs, upAt, downAt, backAt);
+  printf("watchdog %s, longest refresh gap %lu ms, resets %lu\n",
+         host::watchdogStarted() ? "on" : "off", host::watchdogLongestGapMs(),
+         (unsigned long)host::watchdogResets());
+
+  // begin() only hands the join to the modem
+  CHECK(initMs < 100);
+  CHECK(longestPassMs < 100);
+#ifdef FAILSAFE_HW_WATCHDOG
+  CHECK(host::watchdogStarted());
+#endif
+  CHECK(host::watchdogResets() == 0);
+  CHECK(host::watchdogLongestGapMs() < FailsafeManager::HW_WATCHDOG_MS / 4);
+  // polled from CONNECTING by the 1 Hz wifi task
+  CHECK(upAt >= JOIN_MS && upAt < JOIN_MS + 1100);
+  CHECK(downAt >= LOSS_AT_MS && downAt < LOSS_AT_MS + 1100);
+  CHECK(backAt >= BACK_AT_MS && backAt < BACK_AT_MS + JOIN_MS + 2100);
+
+  return failures ? 1 : 0;
+}
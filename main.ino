@@ -21,9 +21,9 @@ void setup() {
   Serial.println();
   Serial.println("========================================");
   Serial.println("System Ready!");
-  Serial.print("IP Address: ");
-  Serial.println(state.getIPAddress());
-  Serial.println("Open browser and navigate to the IP above");
+  Serial.println("WiFi connects in the background; the IP address is");
+  Serial.println("logged and shown on the display once it is up.");
+  Serial.println("Open browser and navigate to that IP");
   Serial.println("========================================");
   Serial.println();
 }
@@ -32,9 +32,6 @@ void loop() {
   unsigned long now = millis();
   
   // Update all subsystems through StateManager
+  // (each manager runs at its own rate, see the task table in StateManager::init)
   state.update(now);
-  
-  // Optional: Add a small delay to prevent overwhelming the system
-  // Remove this if you need maximum responsiveness
-  delay(10);
 }
\ No newline at end of file
@@ -0,0 +1,85 @@
+#!/usr/bin/env python3
+"""Pack the control UI in web/ into WebAssets.h.
+
+Every asset is gzipped at build time and stored in flash together with a
+strong ETag derived from its uncompressed content, so the web server can
+answer with Content-Encoding: gzip or a bare 304 Not Modified.
+
+Run from the sketch directory whenever something under web/ changes:
+
+    python3 tools/gen_assets.py
+"""
+
+import gzip
+import hashlib
+import os
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+WEB_DIR = os.path.join(ROOT, "web")
+OUT_FILE = os.path.join(ROOT, "WebAssets.h")
+
+# (file under web/, URL path, Content-Type)
+ASSETS = [
+    ("index.html", "/", "text/html; charset=utf-8"),
+]
+
+
+def symbol_for(name):
+    return "ASSET_" + "".join(c if c.isalnum() else "_" for c in name).upper()
+
+
+def byte_rows(data, per_row=16):
+    for i in range(0, len(data), per_row):
+        yield ", ".join("0x%02x" % b for b in data[i:i + per_row])
+
+
+def main():
+    out = []
+    out.append("// Generated by tools/gen_assets.py from web/ -- do not edit.")
+    out.append("#ifndef WEB_ASSETS_H")
+    out.append("#define WEB_ASSETS_H")
+    out.append("")
+    out.append("#include <Arduino.h>")
+    out.append("")
+    out.append("struct WebAsset {")
+    out.append("  const char* path;")
+    out.append("  const char* contentType;")
+    out.append("  const uint8_t* data; // gzip stream")
+    out.append("  size_t len;")
+    out.append("  const char* etag;    // quoted, strong")
+    out.append("};")
+    out.append("")
+
+    table = []
+    for name, path, content_type in ASSETS:
+        with open(os.path.join(WEB_DIR, name), "rb") as f:
+            raw = f.read()
+        # mtime=0 keeps the output byte-identical between builds
+        packed = gzip.compress(raw, compresslevel=9, mtime=0)
+        etag = '"%s"' % hashlib.sha256(raw).hexdigest()[:16]
+        sym = symbol_for(name)
+
+        out.append("// %s: %d bytes, %d gzipped" % (name, len(raw), len(packed)))
+        out.append("static const uint8_t %s[] PROGMEM = {" % sym)
+        for row in byte_rows(packed):
+            out.append("  %s," % row)
+        out.append("};")
+        out.append("")
+        table.append('  {"%s", "%s", %s, sizeof(%s), "\\"%s\\""},'
+                     % (path, content_type, sym, sym, etag.strip('"')))
+
+    out.append("static const WebAsset WEB_ASSETS[] = {")
+    out.extend(table)
+    out.append("};")
+    out.append("static const size_t WEB_ASSET_COUNT = sizeof(WEB_ASSETS) / sizeof(WEB_ASSETS[0]);")
+    out.append("")
+    out.append("#endif")
+
+    with open(OUT_FILE, "w", newline="\n") as f:
+        f.write("\n".join(out) + "\n")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())